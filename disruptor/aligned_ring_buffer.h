@@ -0,0 +1,121 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_ALIGNED_RING_BUFFER_H_  // NOLINT
+#define DISRUPTOR_ALIGNED_RING_BUFFER_H_  // NOLINT
+
+#include <array>
+#include <cstdint>
+
+#include "disruptor/ring_buffer.h"
+#include "disruptor/utils.h"
+
+namespace disruptor {
+
+// Slot alignments of an Aligned<T, A> ring.
+//
+// Events packed back to back like in RingBuffer<T, N>, small events share
+// their cache line with their neighbours.
+constexpr size_t kPackedSlots = 0;
+// Every event starts its own cache line, a publisher writing a slot never
+// invalidates the line a consumer reads the previous slot from.
+constexpr size_t kLineAlignedSlots = kCacheLinePadding;
+// Every event starts its own pair of cache lines, also defeating the
+// adjacent line prefetcher pulling the neighbour line of every miss.
+constexpr size_t kLinePairAlignedSlots = 2 * kCacheLinePadding;
+
+// Event storage tag selecting the RingBuffer aligning each slot on A bytes.
+//
+// @param <T> event type, default constructible.
+// @param <A> slot alignment, kPackedSlots or a power of 2.
+template <typename T, size_t A = kLineAlignedSlots>
+struct Aligned {};
+
+// A single event padded to the slot alignment.
+template <typename T, size_t A>
+struct alignas(A == kPackedSlots ? alignof(T) : A) AlignedSlot {
+  T event;
+};
+
+// Ring buffer storing each event in a slot aligned on A bytes, trading
+// memory for the false sharing between publishers and consumers of small
+// events.
+//
+// The slots are only aligned on the hardware lines if the ring itself is,
+// e.g. as a static or an automatic object. operator new does not honour the
+// alignment in C++11, a ring on the heap needs an aligned allocator.
+//
+// @param <T> event type
+// @param <A> slot alignment
+// @param <N> size of the ring
+template <typename T, size_t A, size_t N>
+class RingBuffer<Aligned<T, A>, N> {
+ public:
+  using reference = T&;
+  using const_reference = const T&;
+
+  // Construct a RingBuffer with value-initialized events.
+  RingBuffer() : slots_() {}
+
+  static_assert(((N > 0) && ((N & (~N + 1)) == N)),
+                "RingBuffer's size must be a positive power of 2");
+  static_assert(((A & (~A + 1)) == A),
+                "Slot alignment must be kPackedSlots or a power of 2");
+
+  // Get the event for a given sequence in the RingBuffer.
+  //
+  // @param sequence for the event
+  // @return event reference at the specified sequence position.
+  T& operator[](const int64_t& sequence) {
+    return slots_[sequence & (N - 1)].event;
+  }
+
+  const T& operator[](const int64_t& sequence) const {
+    return slots_[sequence & (N - 1)].event;
+  }
+
+  // Prefetch the event at a given sequence before reading it.
+  //
+  // @param sequence for the event.
+  void Prefetch(const int64_t& sequence) const {
+    PrefetchObject<false>(&slots_[sequence & (N - 1)].event);
+  }
+
+  // Prefetch the event at a given sequence before writing it.
+  //
+  // @param sequence for the event.
+  void PrefetchForWrite(const int64_t& sequence) {
+    PrefetchObject<true>(&slots_[sequence & (N - 1)].event);
+  }
+
+ private:
+  std::array<AlignedSlot<T, A>, N> slots_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(RingBuffer);
+};
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_ALIGNED_RING_BUFFER_H_ NOLINT
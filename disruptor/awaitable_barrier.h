@@ -0,0 +1,254 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_AWAITABLE_BARRIER_H_  // NOLINT
+#define DISRUPTOR_AWAITABLE_BARRIER_H_  // NOLINT
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "disruptor/sequence.h"
+#include "disruptor/wait_strategy.h"
+
+namespace disruptor {
+
+class CoroutineStrategy;
+
+// Awaiter returned by AwaitableBarrier::wait_for(), resuming the coroutine
+// with the same value SequenceBarrier::WaitFor() would return.
+class SequenceAwaiter {
+ public:
+  SequenceAwaiter(const int64_t& sequence, const Sequence& cursor,
+                  const std::vector<Sequence*>& dependents,
+                  const std::atomic<bool>& alerted,
+                  CoroutineStrategy& strategy)
+      : sequence_(sequence),
+        cursor_(cursor),
+        dependents_(dependents),
+        alerted_(alerted),
+        strategy_(strategy),
+        result_(kInitialCursorValue),
+        next_(nullptr) {}
+
+  bool await_ready() { return TryComplete(); }
+
+  inline bool await_suspend(std::coroutine_handle<> handle);
+
+  int64_t await_resume() const { return result_; }
+
+ private:
+  // Check whether the awaited sequence is available or the barrier alerted.
+  bool TryComplete() {
+    if (alerted_.load(std::memory_order_acquire)) {
+      result_ = kAlertedSignal;
+      return true;
+    }
+
+    const int64_t available_sequence = dependents_.size()
+                                           ? GetMinimumSequence(dependents_)
+                                           : cursor_.sequence();
+    if (available_sequence < sequence_) return false;
+
+    result_ = available_sequence;
+    return true;
+  }
+
+  const int64_t sequence_;
+  const Sequence& cursor_;
+  const std::vector<Sequence*>& dependents_;
+  const std::atomic<bool>& alerted_;
+  CoroutineStrategy& strategy_;
+  std::coroutine_handle<> handle_;
+  int64_t result_;
+  // intrusive list of suspended awaiters.
+  SequenceAwaiter* next_;
+
+  friend class CoroutineStrategy;
+};
+
+// Wait strategy suspending coroutines instead of threads. Coroutines
+// awaiting an AwaitableBarrier are queued and resumed by
+// SignalAllWhenBlocking(), either inline on the publishing thread or by
+// handing them to a scheduler, so thousands of low-rate consumers can
+// share a few threads.
+//
+// Awaiters gated on dependents are re-checked on every signal, consumers
+// advancing a dependent sequence may call SignalAllWhenBlocking() as well
+// to resume their downstream coroutines early. Threads waiting through
+// WaitFor() use a YieldingStrategy.
+class CoroutineStrategy {
+ public:
+  using Scheduler = std::function<void(std::coroutine_handle<>)>;
+
+  CoroutineStrategy() : waiting_(0), head_(nullptr) {}
+
+  // Resume coroutines through a scheduler instead of on the publisher's
+  // thread, must be set before any coroutine waits.
+  //
+  // @param scheduler  called with every coroutine ready to resume.
+  void set_scheduler(Scheduler scheduler) { scheduler_ = std::move(scheduler); }
+
+  int64_t WaitFor(const int64_t& sequence, const Sequence& cursor,
+                  const std::vector<Sequence*>& dependents,
+                  const std::atomic<bool>& alerted) {
+    return yielding_strategy_.WaitFor(sequence, cursor, dependents, alerted);
+  }
+
+  template <class R, class P>
+  int64_t WaitFor(const int64_t& sequence, const Sequence& cursor,
+                  const std::vector<Sequence*>& dependents,
+                  const std::atomic<bool>& alerted,
+                  const std::chrono::duration<R, P>& timeout) {
+    return yielding_strategy_.WaitFor(sequence, cursor, dependents, alerted,
+                                      timeout);
+  }
+
+  void SignalAllWhenBlocking() {
+    // pairs with the fence in Suspend(), either the awaiter sees the new
+    // cursor or we see it waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!waiting_.load(std::memory_order_relaxed)) return;
+
+    SequenceAwaiter* ready = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      SequenceAwaiter** link = &head_;
+      while (*link) {
+        SequenceAwaiter* awaiter = *link;
+        if (awaiter->TryComplete()) {
+          *link = awaiter->next_;
+          awaiter->next_ = ready;
+          ready = awaiter;
+          waiting_.fetch_sub(1, std::memory_order_relaxed);
+        } else {
+          link = &awaiter->next_;
+        }
+      }
+    }
+
+    while (ready) {
+      // the awaiter lives in the coroutine frame, read it before resuming.
+      SequenceAwaiter* next = ready->next_;
+      Resume(ready->handle_);
+      ready = next;
+    }
+  }
+
+ private:
+  // Queue a suspending awaiter.
+  //
+  // @return false if the awaiter completed meanwhile and must not suspend.
+  bool Suspend(SequenceAwaiter* awaiter) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    waiting_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (awaiter->TryComplete()) {
+      waiting_.fetch_sub(1, std::memory_order_relaxed);
+      return false;
+    }
+    awaiter->next_ = head_;
+    head_ = awaiter;
+    return true;
+  }
+
+  void Resume(std::coroutine_handle<> handle) {
+    if (scheduler_)
+      scheduler_(handle);
+    else
+      handle.resume();
+  }
+
+  YieldingStrategy<> yielding_strategy_;
+  Scheduler scheduler_;
+  std::mutex mutex_;
+  std::atomic<int64_t> waiting_;
+  SequenceAwaiter* head_;
+
+  friend class SequenceAwaiter;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(CoroutineStrategy);
+};
+
+bool SequenceAwaiter::await_suspend(std::coroutine_handle<> handle) {
+  handle_ = handle;
+  return strategy_.Suspend(this);
+}
+
+// Barrier awaited from coroutines, `co_await barrier.wait_for(sequence)`
+// suspends until the sequence is available or the barrier is alerted.
+//
+// The CoroutineStrategy must be the one signaled by the sequencer, see
+// Sequencer::wait_strategy().
+class AwaitableBarrier {
+ public:
+  AwaitableBarrier(const Sequence& cursor,
+                   const std::vector<Sequence*>& dependents,
+                   CoroutineStrategy& wait_strategy)
+      : wait_strategy_(wait_strategy),
+        cursor_(cursor),
+        dependents_(dependents),
+        alerted_(false) {}
+
+  // Wait for the given sequence to be available for consumption.
+  //
+  // @return an awaitable resuming with kAlertedSignal if the barrier was
+  //         alerted, otherwise the greatest available sequence.
+  SequenceAwaiter wait_for(const int64_t& sequence) {
+    return SequenceAwaiter(sequence, cursor_, dependents_, alerted_,
+                           wait_strategy_);
+  }
+
+  int64_t get_sequence() const { return cursor_.sequence(); }
+
+  bool alerted() const {
+    return alerted_.load(std::memory_order_acquire);
+  }
+
+  // Alerting the barrier resumes its suspended coroutines.
+  void set_alerted(bool alert) {
+    alerted_.store(alert, std::memory_order_release);
+    if (alert) wait_strategy_.SignalAllWhenBlocking();
+  }
+
+ private:
+  CoroutineStrategy& wait_strategy_;
+  const Sequence& cursor_;
+  const std::vector<Sequence*> dependents_;
+  std::atomic<bool> alerted_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(AwaitableBarrier);
+};
+
+};  // namespace disruptor
+
+#endif  // __cpp_impl_coroutine
+
+#endif  // DISRUPTOR_AWAITABLE_BARRIER_H_ NOLINT
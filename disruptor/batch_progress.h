@@ -0,0 +1,112 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_BATCH_PROGRESS_H_  // NOLINT
+#define DISRUPTOR_BATCH_PROGRESS_H_  // NOLINT
+
+#include <cstdint>
+
+#include "disruptor/sequence.h"
+#include "disruptor/utils.h"
+
+namespace disruptor {
+
+constexpr int64_t kDefaultProgressInterval = 64L;
+// Only publish the consumer's sequence at the end of a batch.
+constexpr int64_t kProgressAtEndOfBatch = INT64_MAX;
+
+// Publish a consumer's progress while it is still inside a batch, releasing
+// the publishers gated on its {@link Sequence} before the end of a long
+// batch.
+//
+// The consumer reports every processed sequence with Processed(), the
+// sequence is written every `interval` events, on demand with Publish(),
+// and at the end of the batch. The last published value is tracked locally
+// so the contended sequence line is only touched to write it.
+//
+// Given the sequencer's requested sequence, the progress is also published
+// as soon as a publisher waits for this consumer to move past its last
+// published sequence. The request line is only written by gated publishers,
+// watching it costs a load from a line shared in the consumer's cache.
+class BatchProgress {
+ public:
+  // Construct a reporter for a consumer's sequence.
+  //
+  // @param sequence   of the consumer, gating the publishers.
+  // @param interval   processed events between two publications.
+  // @param requested  sequence publishers are waiting for, see
+  //                   Sequencer::requested_sequence(), nullptr to ignore.
+  BatchProgress(Sequence& sequence, int64_t interval = kDefaultProgressInterval,
+                const Sequence* requested = nullptr)
+      : sequence_(sequence),
+        requested_(requested),
+        interval_(interval),
+        processed_(sequence.sequence()),
+        published_(processed_) {}
+
+  // Record that the event at `sequence` was processed, publishing it if
+  // `interval` events were processed since the last publication or if a
+  // publisher requested it.
+  //
+  // @param sequence of the processed event.
+  void Processed(const int64_t& sequence) {
+    processed_ = sequence;
+    if (processed_ - published_ >= interval_ || Requested()) Publish();
+  }
+
+  // Is a publisher waiting for this consumer's unpublished progress.
+  bool Requested() const {
+    return requested_ != nullptr && requested_->sequence() > published_;
+  }
+
+  // Publish the last processed sequence now.
+  void Publish() {
+    if (processed_ == published_) return;
+    sequence_.set_sequence(processed_);
+    published_ = processed_;
+  }
+
+  // Resynchronize with the sequence after it was set externally.
+  void Reset() { processed_ = published_ = sequence_.sequence(); }
+
+  // Get the last processed sequence, published or not.
+  int64_t processed() const { return processed_; }
+
+  // Get the last sequence visible to the publishers.
+  int64_t published() const { return published_; }
+
+ private:
+  Sequence& sequence_;
+  const Sequence* requested_;
+  const int64_t interval_;
+  int64_t processed_;
+  int64_t published_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(BatchProgress);
+};
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_BATCH_PROGRESS_H_ NOLINT
@@ -0,0 +1,140 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_BATCHING_PUBLISHER_H_  // NOLINT
+#define DISRUPTOR_BATCHING_PUBLISHER_H_  // NOLINT
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+#include "disruptor/sequence.h"
+#include "disruptor/utils.h"
+
+namespace disruptor {
+
+constexpr size_t kDefaultPublishBatchSize = 64;
+constexpr std::chrono::microseconds kDefaultPublishMaxDelay(10);
+
+// Publisher accumulating the events it commits and publishing them with a
+// single Sequencer::Publish(sequence, delta), i.e. a single cursor update
+// and wake-up of the consumers for the whole batch.
+//
+// The batch is published once it holds `batch_size` events, once its
+// oldest event waited `max_delay`, or on demand with Flush(). A publisher
+// without events to commit calls Poll() to honour the deadline, otherwise
+// the last batch waits for the next event. It is also published before
+// claiming a sequence would wait for the consumers, which may be waiting
+// for the batch, and when the publisher is destroyed.
+//
+// Batches hold contiguous sequences, a claim not following the batch, e.g.
+// on a MultiThreadedStrategy shared by several publishers, publishes it
+// first. A pending batch also holds back the publications of the other
+// publishers of such a strategy, batching best suits a single publisher.
+//
+// @param <S> sequencer of the events.
+template <typename S>
+class BatchingPublisher {
+ public:
+  // Construct a publisher batching the events of a sequencer.
+  //
+  // @param sequencer   to claim and publish sequences from.
+  // @param batch_size  events published at once, smaller than the ring.
+  // @param max_delay   an event may wait for its batch to be published.
+  BatchingPublisher(
+      S& sequencer, size_t batch_size = kDefaultPublishBatchSize,
+      std::chrono::microseconds max_delay = kDefaultPublishMaxDelay)
+      : sequencer_(sequencer),
+        batch_size_(batch_size),
+        max_delay_(max_delay),
+        pending_(0),
+        last_(kInitialCursorValue) {}
+
+  ~BatchingPublisher() { Flush(); }
+
+  // Claim the next sequence, publishing the pending batch first if the
+  // claim would wait for the consumers or does not extend the batch.
+  //
+  // @return the claimed sequence.
+  int64_t Claim() {
+    if (pending_ && !sequencer_.HasAvailableCapacity()) Flush();
+    const int64_t sequence = sequencer_.Claim();
+    if (pending_ && sequence != last_ + 1) Flush();
+    return sequence;
+  }
+
+  // Get the event of a claimed sequence.
+  auto operator[](const int64_t& sequence)
+      -> decltype(std::declval<S&>()[sequence]) {
+    return sequencer_[sequence];
+  }
+
+  // Add the event at the last claimed sequence to the batch, publishing the
+  // batch if it is full or past its deadline.
+  //
+  // @param sequence last claimed.
+  void Publish(const int64_t& sequence) {
+    const Clock::time_point now = Clock::now();
+    if (pending_ == 0) deadline_ = now + max_delay_;
+    pending_++;
+    last_ = sequence;
+    if (pending_ >= batch_size_ || now >= deadline_) Flush();
+  }
+
+  // Publish the pending batch if its deadline passed.
+  //
+  // @return true if a batch was published.
+  bool Poll() {
+    if (pending_ == 0 || Clock::now() < deadline_) return false;
+    Flush();
+    return true;
+  }
+
+  // Publish the pending batch now.
+  void Flush() {
+    if (pending_ == 0) return;
+    sequencer_.Publish(last_, pending_);
+    pending_ = 0;
+  }
+
+  // Get the number of events committed but not published yet.
+  size_t pending() const { return pending_; }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  S& sequencer_;
+  const size_t batch_size_;
+  const Clock::duration max_delay_;
+  size_t pending_;
+  int64_t last_;
+  Clock::time_point deadline_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(BatchingPublisher);
+};
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_BATCHING_PUBLISHER_H_ NOLINT
@@ -57,9 +57,27 @@ class ClaimStrategy {
 
   void SynchronizePublishing(const int64_t& sequence, const Sequence& cursor,
                              const size_t& delta) {}
+
+  // Make the claimed sequences up to `sequence` visible by moving the
+  // cursor, with a store-release once the previous claims are published.
+  void Publish(const int64_t& sequence, Sequence& cursor, const size_t& delta);
+
+  // Get the consumer sequence the publishers are waiting for, consumers
+  // deferring the publication of their own sequence publish it early when
+  // they are behind this request.
+  const Sequence& requested_sequence() const;
+
+  // Forget every claim, e.g. after a warm-up. No publisher may be running.
+  void Reset();
 };
 */
 
+// used internally, record that a publisher is gated until the consumers
+// reach `sequence`.
+static inline void RequestSequence(Sequence& requested, int64_t sequence) {
+  if (requested.sequence() < sequence) requested.set_sequence(sequence);
+}
+
 template <size_t N>
 class SingleThreadedStrategy;
 using kDefaultClaimStrategy = SingleThreadedStrategy<kDefaultRingBufferSize>;
@@ -77,10 +95,13 @@ class SingleThreadedStrategy {
     const int64_t next_sequence = (last_claimed_sequence_ += delta);
     const int64_t wrap_point = next_sequence - N;
     if (last_consumer_sequence_ < wrap_point) {
-      while (GetMinimumSequence(dependents) < wrap_point) {
+      int64_t min_sequence = kInitialCursorValue;
+      while ((min_sequence = GetMinimumSequence(dependents)) < wrap_point) {
+        RequestSequence(requested_sequence_, wrap_point);
         // TODO: configurable yield strategy
         std::this_thread::yield();
       }
+      last_consumer_sequence_ = min_sequence;
     }
     return next_sequence;
   }
@@ -90,7 +111,10 @@ class SingleThreadedStrategy {
     if (wrap_point > last_consumer_sequence_) {
       const int64_t min_sequence = GetMinimumSequence(dependents);
       last_consumer_sequence_ = min_sequence;
-      if (wrap_point > min_sequence) return false;
+      if (wrap_point > min_sequence) {
+        RequestSequence(requested_sequence_, wrap_point);
+        return false;
+      }
     }
     return true;
   }
@@ -98,27 +122,78 @@ class SingleThreadedStrategy {
   void SynchronizePublishing(const int64_t& sequence, const Sequence& cursor,
                              const size_t& delta) {}
 
+  // The single publisher is the only writer of the cursor, a store-release
+  // is enough, without a read-modify-write.
+  void Publish(const int64_t& sequence, Sequence& cursor,
+               const size_t& /*delta*/) {
+    cursor.set_sequence(sequence);
+  }
+
+  const Sequence& requested_sequence() const { return requested_sequence_; }
+
+  void Reset() {
+    last_claimed_sequence_ = kInitialCursorValue;
+    last_consumer_sequence_ = kInitialCursorValue;
+    requested_sequence_.set_sequence(kInitialCursorValue);
+  }
+
  private:
   // We do not need to use atomic values since this function is called by a
   // single publisher.
   int64_t last_claimed_sequence_;
   int64_t last_consumer_sequence_;
 
+  Sequence requested_sequence_;
+
   DISALLOW_COPY_MOVE_AND_ASSIGN(SingleThreadedStrategy);
 };
 
-// Optimised strategy can be used when there is a single publisher thread.
-template <size_t N = kDefaultRingBufferSize>
+// Lease size of a MultiThreadedStrategy claiming every sequence from the
+// shared counter.
+constexpr size_t kNoLease = 0;
+
+// Block of sequences reserved at once by a publisher and handed out locally,
+// owned by a single publisher thread.
+struct SequenceLease {
+  SequenceLease() : next(kFirstSequenceValue), last(kInitialCursorValue) {}
+
+  // Get the number of reserved sequences not claimed yet.
+  int64_t remaining() const { return last - next + 1L; }
+
+  int64_t next;
+  int64_t last;
+};
+
+// Strategy to be used when there are multiple publisher threads.
+//
+// Without leases publishers claim from a shared counter and publish in the
+// order of their claims. With leases of L sequences, each publisher
+// reserves L sequences with a single increment of the shared counter and
+// claims from its lease without touching it, so publishers commit their
+// sequences out of order: each published sequence is marked in an
+// availability buffer and the cursor is moved over the contiguous published
+// sequences by whichever publisher fills the gap.
+//
+// The cursor cannot move past a sequence leased but not published yet, a
+// publisher going idle or shutting down must hand back the rest of its
+// lease, see Sequencer::ReleaseLease().
+template <size_t N = kDefaultRingBufferSize, size_t L = kNoLease>
 class MultiThreadedStrategy {
  public:
-  MultiThreadedStrategy() {}
+  static_assert(L < N, "a lease must be smaller than the ring");
+
+  MultiThreadedStrategy() { Reset(); }
 
   int64_t IncrementAndGet(const std::vector<Sequence*>& dependents,
                           size_t delta = 1) {
-    const int64_t next_sequence = last_claimed_sequence_.IncrementAndGet(delta);
+    // the counter only hands out unique sequences, the events are published
+    // by the cursor.
+    const int64_t next_sequence = last_claimed_sequence_.IncrementAndGet(
+        delta, std::memory_order_relaxed);
     const int64_t wrap_point = next_sequence - N;
     if (last_consumer_sequence_.sequence() < wrap_point) {
       while (GetMinimumSequence(dependents) < wrap_point) {
+        RequestSequence(requested_sequence_, wrap_point);
         // TODO: configurable yield strategy
         std::this_thread::yield();
       }
@@ -126,12 +201,32 @@ class MultiThreadedStrategy {
     return next_sequence;
   }
 
+  // Claim the next sequence of a publisher's lease, reserving a new lease
+  // of L sequences once it is exhausted.
+  //
+  // @param dependents  dependents sequences to wait on (mostly consumers).
+  // @param lease       of the calling publisher.
+  //
+  // @return claimed sequence.
+  int64_t IncrementAndGet(const std::vector<Sequence*>& dependents,
+                          SequenceLease& lease) {
+    static_assert(L != kNoLease, "lease claims require a lease size");
+    if (lease.remaining() <= 0) {
+      lease.last = IncrementAndGet(dependents, L);
+      lease.next = lease.last - L + 1L;
+    }
+    return lease.next++;
+  }
+
   bool HasAvailableCapacity(const std::vector<Sequence*>& dependents) {
     const int64_t wrap_point = last_claimed_sequence_.sequence() + 1L - N;
     if (wrap_point > last_consumer_sequence_.sequence()) {
       const int64_t min_sequence = GetMinimumSequence(dependents);
       last_consumer_sequence_.set_sequence(min_sequence);
-      if (wrap_point > min_sequence) return false;
+      if (wrap_point > min_sequence) {
+        RequestSequence(requested_sequence_, wrap_point);
+        return false;
+      }
     }
     return true;
   }
@@ -146,13 +241,72 @@ class MultiThreadedStrategy {
     }
   }
 
+  // Without leases publishers move the cursor in the order of their claims,
+  // once the previous claims are published this publisher is the only
+  // writer and a store-release is enough.
+  void Publish(const int64_t& sequence, Sequence& cursor,
+               const size_t& delta) {
+    if (L == kNoLease) {
+      SynchronizePublishing(sequence, cursor, delta);
+      cursor.set_sequence(sequence);
+      return;
+    }
+
+    for (int64_t published = sequence - delta + 1; published <= sequence;
+         published++)
+      available_[published & (N - 1)].store(published,
+                                            std::memory_order_release);
+
+    // either this publisher sees the cursor moved by the publisher of the
+    // previous gap, or that publisher sees the sequences marked above.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    AdvanceCursor(cursor);
+  }
+
+  const Sequence& requested_sequence() const { return requested_sequence_; }
+
+  void Reset() {
+    last_claimed_sequence_.set_sequence(kInitialCursorValue);
+    last_consumer_sequence_.set_sequence(kInitialCursorValue);
+    requested_sequence_.set_sequence(kInitialCursorValue);
+    // slot i is first published with sequence i.
+    for (size_t i = 0; i < kAvailableSlots; i++)
+      available_[i].store(static_cast<int64_t>(i) - static_cast<int64_t>(N),
+                          std::memory_order_relaxed);
+  }
+
  private:
+  static constexpr size_t kAvailableSlots = L == kNoLease ? 1 : N;
+
+  // Move the cursor over every contiguous published sequence.
+  void AdvanceCursor(Sequence& cursor) {
+    int64_t current = cursor.sequence();
+    while (true) {
+      int64_t highest = current;
+      while (available_[(highest + 1L) & (N - 1)].load() == highest + 1L)
+        highest++;
+
+      // the next sequence belongs to a publisher that will move the cursor.
+      if (highest == current) return;
+
+      if (!cursor.CompareAndSet(current, highest))
+        current = cursor.sequence();
+      else
+        current = highest;
+    }
+  }
+
   Sequence last_claimed_sequence_;
   Sequence last_consumer_sequence_;
+  Sequence requested_sequence_;
+  std::atomic<int64_t> available_[kAvailableSlots];
 
   DISALLOW_COPY_MOVE_AND_ASSIGN(MultiThreadedStrategy);
 };
 
+template <size_t N, size_t L>
+constexpr size_t MultiThreadedStrategy<N, L>::kAvailableSlots;
+
 };  // namespace disruptor
 
 #endif  // DISRUPTOR_CLAIM_STRATEGY_H_ NOLINT
@@ -0,0 +1,166 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_COLUMN_RING_BUFFER_H_  // NOLINT
+#define DISRUPTOR_COLUMN_RING_BUFFER_H_  // NOLINT
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+
+#include "disruptor/ring_buffer.h"
+#include "disruptor/sequence.h"
+
+namespace disruptor {
+
+// Event layout tag selecting the struct-of-arrays RingBuffer: every field
+// type Ts... is stored in its own column instead of packing whole events
+// together, so a stage reading a single field only pulls that column through
+// the cache.
+//
+// @param <Ts> field types of the event, in column order.
+template <typename... Ts>
+struct Columns {};
+
+// A single column of the ring, aligned on a cache line so that two columns
+// never share a line.
+template <typename T, size_t N>
+struct alignas(kCacheLinePadding) Column {
+  std::array<T, N> values;
+};
+
+// Ring buffer storing each field of the event in a separate column.
+//
+// Events are accessed through a Slot proxy, field by field, with
+// `ring[sequence].get<I>()`. Stages working on a whole published range can
+// also walk a column directly, a range [lo, hi] maps to at most two
+// contiguous spans of `column<I>()`, which lets the compiler vectorize.
+//
+// @param <Ts> field types of the event
+// @param <N> size of the ring
+template <typename... Ts, size_t N>
+class RingBuffer<Columns<Ts...>, N> {
+ public:
+  template <size_t I>
+  using column_type = typename std::tuple_element<I, std::tuple<Ts...>>::type;
+
+  // Proxy to the fields of the event stored at a given sequence.
+  template <bool Const>
+  class BasicSlot {
+   public:
+    template <size_t I>
+    using field_type = typename std::conditional<Const, const column_type<I>,
+                                                 column_type<I>>::type;
+
+    // Get the field I of the event.
+    //
+    // @return reference to the field in its column.
+    template <size_t I>
+    field_type<I>& get() const {
+      return ring_->template column<I>()[index_];
+    }
+
+   private:
+    using Ring =
+        typename std::conditional<Const, const RingBuffer, RingBuffer>::type;
+
+    BasicSlot(Ring* ring, size_t index) : ring_(ring), index_(index) {}
+
+    Ring* ring_;
+    size_t index_;
+
+    friend class RingBuffer;
+  };
+
+  using reference = BasicSlot<false>;
+  using const_reference = BasicSlot<true>;
+
+  // Construct a RingBuffer with value-initialized columns.
+  RingBuffer() : columns_() {}
+
+  static_assert(((N > 0) && ((N & (~N + 1)) == N)),
+                "RingBuffer's size must be a positive power of 2");
+  static_assert(sizeof...(Ts) > 0, "Columns must have at least one field");
+
+  // Get the event proxy for a given sequence in the RingBuffer.
+  //
+  // @param sequence for the event
+  // @return proxy to the fields at the specified sequence position.
+  reference operator[](const int64_t& sequence) {
+    return reference(this, sequence & (N - 1));
+  }
+
+  const_reference operator[](const int64_t& sequence) const {
+    return const_reference(this, sequence & (N - 1));
+  }
+
+  // Get the storage of a single field.
+  //
+  // @return the column of field I, indexed by `sequence & (N - 1)`.
+  template <size_t I>
+  std::array<column_type<I>, N>& column() {
+    return std::get<I>(columns_).values;
+  }
+
+  template <size_t I>
+  const std::array<column_type<I>, N>& column() const {
+    return std::get<I>(columns_).values;
+  }
+
+  // Prefetch the fields at a given sequence, one line per column, before
+  // reading them.
+  //
+  // @param sequence for the event.
+  void Prefetch(const int64_t& sequence) const {
+    PrefetchColumns<false>(sequence & (N - 1));
+  }
+
+  // Prefetch the fields at a given sequence before writing them.
+  //
+  // @param sequence for the event.
+  void PrefetchForWrite(const int64_t& sequence) {
+    PrefetchColumns<true>(sequence & (N - 1));
+  }
+
+ private:
+  template <bool Write, size_t I = 0>
+  typename std::enable_if<(I < sizeof...(Ts))>::type PrefetchColumns(
+      size_t index) const {
+    PrefetchObject<Write>(&std::get<I>(columns_).values[index]);
+    PrefetchColumns<Write, I + 1>(index);
+  }
+
+  template <bool Write, size_t I>
+  typename std::enable_if<(I == sizeof...(Ts))>::type PrefetchColumns(
+      size_t) const {}
+
+  std::tuple<Column<Ts, N>...> columns_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(RingBuffer);
+};
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_COLUMN_RING_BUFFER_H_ NOLINT
@@ -0,0 +1,239 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_CONFLATING_SEQUENCER_H_  // NOLINT
+#define DISRUPTOR_CONFLATING_SEQUENCER_H_  // NOLINT
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "disruptor/claim_strategy.h"
+#include "disruptor/sequencer.h"
+
+namespace disruptor {
+
+// Single publisher sequencer conflating the updates of a key: an update for
+// a key whose previous update was not consumed yet overwrites it in place
+// instead of taking a new sequence, so a consumer falling behind only sees
+// the latest value of each key and its work is bounded by the number of
+// distinct keys.
+//
+// The publisher indexes the last sequence of every key still in the ring,
+// at most N keys, in a fixed open addressing table allocated once: a key
+// leaves the index with its slot and publishing never allocates. Each slot
+// carries a state, odd while the publisher overwrites the value, even once
+// written, and marked once consumed. The publisher only overwrites a slot
+// it moves from even to odd and the consumer only takes a value it marks
+// consumed from the even state it read, so each update is either conflated
+// before being taken or published in a new slot.
+//
+// The single consumer must Take() every sequence before moving its gating
+// {@link Sequence} past it.
+//
+// @param <K> key type, hashable and default constructible.
+// @param <T> value type, trivially copyable.
+// @param <N> size of the ring
+// @param <W> wait strategy of the consumer
+template <typename K, typename T, size_t N = kDefaultRingBufferSize,
+          typename W = kDefaultWaitStrategy>
+class ConflatingSequencer {
+ public:
+  // Construct an empty sequencer.
+  ConflatingSequencer()
+      : sequencer_([](size_t) { return kFreeSlot; }), index_(kIndexSize) {}
+
+  // Set the sequence of the consumer, gating the publisher.
+  //
+  // @param sequences to be gated on.
+  void set_gating_sequences(const std::vector<Sequence*>& sequences) {
+    sequencer_.set_gating_sequences(sequences);
+  }
+
+  // Create a {@link SequenceBarrier} for the consumer.
+  //
+  // @param dependents this barrier will track.
+  // @return the barrier gated as required.
+  std::unique_ptr<SequenceBarrier<W>> NewBarrier(
+      const std::vector<Sequence*>& dependents) {
+    return sequencer_.NewBarrier(dependents);
+  }
+
+  // Get the value of the cursor indicating the published sequence.
+  int64_t GetCursor() { return sequencer_.GetCursor(); }
+
+  // Publish the latest value of a key, overwriting its pending update if
+  // the consumer did not take it yet.
+  //
+  // @param key    of the update.
+  // @param value  of the key.
+  // @return true if the update was conflated, false if it was published
+  //         at a new sequence.
+  bool Publish(const K& key, const T& value) {
+    const size_t pending = Find(key);
+    if (pending != kIndexSize && Overwrite(index_[pending].sequence, value))
+      return true;
+
+    const int64_t sequence = sequencer_.Claim();
+    Slot& slot = sequencer_[sequence];
+    // the update leaving the ring leaves the index with it.
+    Forget(slot.key, slot.sequence);
+
+    const int64_t version = slot.state.load(std::memory_order_relaxed);
+    slot.sequence = sequence;
+    slot.key = key;
+    slot.value = value;
+    slot.state.store((version & ~kConsumed) + 2, std::memory_order_relaxed);
+    sequencer_.Publish(sequence);
+
+    Index(key, sequence);
+    return false;
+  }
+
+  // Take the update at a published sequence, the latest value of its key
+  // at the time, waiting for an overwrite in progress.
+  //
+  // @param sequence available to the consumer.
+  // @return the key and its value.
+  std::pair<K, T> Take(const int64_t& sequence) {
+    Slot& slot = sequencer_[sequence];
+    while (true) {
+      int64_t version = slot.state.load(std::memory_order_acquire);
+      if (version & kWriting) continue;
+
+      std::pair<K, T> update(slot.key, slot.value);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.state.compare_exchange_strong(version, version | kConsumed,
+                                             std::memory_order_relaxed))
+        return update;
+    }
+  }
+
+ private:
+  static_assert(std::is_trivially_copyable<T>::value,
+                "conflated values must be trivially copyable");
+
+  static constexpr int64_t kFreeSlot = 0;
+  static constexpr int64_t kWriting = 1;
+  static constexpr int64_t kConsumed = INT64_C(1) << 62;
+  // twice the keys it holds keeps the probes short.
+  static constexpr size_t kIndexSize = 2 * N;
+
+  struct Slot {
+    explicit Slot(int64_t state)
+        : state(state), sequence(kInitialCursorValue), key(), value() {}
+
+    std::atomic<int64_t> state;
+    int64_t sequence;
+    K key;
+    T value;
+  };
+
+  // Last sequence of a key, kInitialCursorValue for an empty entry.
+  struct IndexEntry {
+    IndexEntry() : sequence(kInitialCursorValue), key() {}
+
+    int64_t sequence;
+    K key;
+  };
+
+  size_t Home(const K& key) const {
+    return std::hash<K>()(key) & (kIndexSize - 1);
+  }
+
+  // @return the position of the key in the index, kIndexSize if absent.
+  size_t Find(const K& key) const {
+    for (size_t i = Home(key); index_[i].sequence != kInitialCursorValue;
+         i = (i + 1) & (kIndexSize - 1))
+      if (index_[i].key == key) return i;
+    return kIndexSize;
+  }
+
+  // Record the last sequence of a key, at most N keys are ever indexed.
+  void Index(const K& key, const int64_t& sequence) {
+    size_t i = Home(key);
+    while (index_[i].sequence != kInitialCursorValue && !(index_[i].key == key))
+      i = (i + 1) & (kIndexSize - 1);
+    index_[i].sequence = sequence;
+    index_[i].key = key;
+  }
+
+  // Remove a key from the index if its last sequence is `sequence`, moving
+  // back the entries probed past it.
+  void Forget(const K& key, const int64_t& sequence) {
+    size_t hole = Find(key);
+    if (hole == kIndexSize || index_[hole].sequence != sequence) return;
+
+    for (size_t i = (hole + 1) & (kIndexSize - 1);
+         index_[i].sequence != kInitialCursorValue;
+         i = (i + 1) & (kIndexSize - 1)) {
+      const size_t home = Home(index_[i].key);
+      // the entry stays if its home lies after the hole.
+      if (((i - home) & (kIndexSize - 1)) >= ((i - hole) & (kIndexSize - 1))) {
+        index_[hole] = index_[i];
+        hole = i;
+      }
+    }
+    index_[hole].sequence = kInitialCursorValue;
+  }
+
+  // Overwrite the value published at `sequence` if it is still pending.
+  bool Overwrite(const int64_t& sequence, const T& value) {
+    Slot& slot = sequencer_[sequence];
+    if (slot.sequence != sequence) return false;
+
+    int64_t version = slot.state.load(std::memory_order_relaxed);
+    if ((version & kConsumed) ||
+        !slot.state.compare_exchange_strong(version, version + kWriting,
+                                            std::memory_order_acquire))
+      return false;
+
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.value = value;
+    slot.state.store(version + 2, std::memory_order_release);
+    return true;
+  }
+
+  Sequencer<Slot, N, SingleThreadedStrategy<N>, W> sequencer_;
+  std::vector<IndexEntry> index_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(ConflatingSequencer);
+};
+
+template <typename K, typename T, size_t N, typename W>
+constexpr int64_t ConflatingSequencer<K, T, N, W>::kFreeSlot;
+template <typename K, typename T, size_t N, typename W>
+constexpr int64_t ConflatingSequencer<K, T, N, W>::kWriting;
+template <typename K, typename T, size_t N, typename W>
+constexpr int64_t ConflatingSequencer<K, T, N, W>::kConsumed;
+template <typename K, typename T, size_t N, typename W>
+constexpr size_t ConflatingSequencer<K, T, N, W>::kIndexSize;
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_CONFLATING_SEQUENCER_H_ NOLINT
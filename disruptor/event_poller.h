@@ -0,0 +1,176 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_EVENT_POLLER_H_  // NOLINT
+#define DISRUPTOR_EVENT_POLLER_H_  // NOLINT
+
+#include <vector>
+
+#include "disruptor/batch_progress.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/sequence.h"
+#include "disruptor/utils.h"
+
+namespace disruptor {
+
+// Outcome of a single EventPoller::Poll() call.
+enum class PollState {
+  // At least one event was handed to the handler.
+  kProcessing,
+  // Events are published but the dependents have not processed them yet.
+  kGating,
+  // Nothing was published since the last poll.
+  kIdle
+};
+
+// When a poller publishes its {@link Sequence}.
+enum class ProgressPolicy {
+  // At the end of every batch, and every `progress_interval` events.
+  kEndOfBatch,
+  // Every `progress_interval` events, when a gated publisher requests it,
+  // and when the poller runs out of events. The sequence line is not
+  // written back and forth with the producer for every small batch, the
+  // poller must be the only consumer moving its sequence.
+  kDeferred
+};
+
+// Non-blocking consumer for threads owning their own loop, e.g. an epoll
+// reactor, that cannot wait inside SequenceBarrier::WaitFor().
+//
+// Each call to Poll() hands every currently available event to the handler
+// and advances the poller's {@link Sequence}, which must be registered as a
+// gating sequence of the sequencer.
+//
+// @param <S> sequencer type, exposing cursor(), operator[], Prefetch() and
+//            requested_sequence(), only read with ProgressPolicy::kDeferred.
+template <typename S>
+class EventPoller {
+ public:
+  // Construct a poller gated on the sequencer's cursor and on a list of
+  // upstream consumers.
+  //
+  // @param sequencer          to consume events from.
+  // @param dependents         sequences that must process an event first.
+  // @param progress_interval  events after which the poller's sequence is
+  //                           published within a batch.
+  // @param policy             when the poller's sequence is published.
+  EventPoller(S& sequencer, const std::vector<Sequence*>& dependents,
+              int64_t progress_interval = kProgressAtEndOfBatch,
+              ProgressPolicy policy = ProgressPolicy::kEndOfBatch)
+      : sequencer_(sequencer),
+        dependents_(dependents),
+        policy_(policy),
+        available_sequence_(kInitialCursorValue),
+        prefetch_distance_(kNoPrefetch),
+        progress_(sequence_, progress_interval,
+                  policy == ProgressPolicy::kDeferred
+                      ? &sequencer.requested_sequence()
+                      : nullptr) {}
+
+  // Process every available event without blocking.
+  //
+  // The handler is called as `bool handler(event, sequence, end_of_batch)`
+  // and returns false to stop the batch early, the remaining events are
+  // left for the next poll.
+  //
+  // @param handler  called for each available event.
+  // @return kProcessing if events were handled, kGating if published events
+  //         are still held by the dependents, kIdle otherwise.
+  template <typename H>
+  PollState Poll(H&& handler) {
+    const int64_t next_sequence = progress_.processed() + 1L;
+    // events left by a batch stopped early are known to be available.
+    if (next_sequence > available_sequence_)
+      available_sequence_ = GetAvailableSequence();
+    const int64_t available_sequence = available_sequence_;
+
+    if (next_sequence <= available_sequence) {
+      for (int64_t sequence = next_sequence; sequence <= available_sequence;
+           sequence++) {
+        if (prefetch_distance_ != kNoPrefetch)
+          sequencer_.Prefetch(sequence + prefetch_distance_);
+        const bool proceed = handler(sequencer_[sequence], sequence,
+                                     sequence == available_sequence);
+        progress_.Processed(sequence);
+        if (!proceed) break;
+      }
+      if (policy_ == ProgressPolicy::kEndOfBatch) progress_.Publish();
+      return PollState::kProcessing;
+    }
+
+    progress_.Publish();
+
+    if (sequencer_.cursor().sequence() >= next_sequence)
+      return PollState::kGating;
+
+    return PollState::kIdle;
+  }
+
+  // Get the sequence of the last processed event.
+  //
+  // @return the {@link Sequence} to gate publishers and downstream consumers.
+  Sequence& sequence() { return sequence_; }
+
+  // Start again from the beginning of the ring, after the sequencer was
+  // Reset().
+  void Reset() {
+    sequence_.set_sequence(kInitialCursorValue);
+    progress_.Reset();
+    available_sequence_ = kInitialCursorValue;
+  }
+
+  // Prefetch the event `distance` sequences ahead of the one handed to the
+  // handler.
+  //
+  // @param distance in sequences, kNoPrefetch to disable.
+  void set_prefetch_distance(int64_t distance) {
+    prefetch_distance_ = distance;
+  }
+
+  // Get the poller's progress reporter, a handler may Publish() it to
+  // release the publishers in the middle of a batch.
+  BatchProgress& progress() { return progress_; }
+
+ private:
+  int64_t GetAvailableSequence() const {
+    // dependents are themselves gated on the cursor.
+    if (!dependents_.size()) return sequencer_.cursor().sequence();
+    return GetMinimumSequence(dependents_);
+  }
+
+  S& sequencer_;
+  const std::vector<Sequence*> dependents_;
+  const ProgressPolicy policy_;
+  int64_t available_sequence_;
+  int64_t prefetch_distance_;
+  Sequence sequence_;
+  BatchProgress progress_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(EventPoller);
+};
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_EVENT_POLLER_H_ NOLINT
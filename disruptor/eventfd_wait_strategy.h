@@ -0,0 +1,185 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_EVENTFD_WAIT_STRATEGY_H_  // NOLINT
+#define DISRUPTOR_EVENTFD_WAIT_STRATEGY_H_  // NOLINT
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <limits>
+#include <system_error>
+#include <vector>
+
+#include "disruptor/sequence.h"
+#include "disruptor/wait_strategy.h"
+
+namespace disruptor {
+
+// Wait strategy exposing the sequencer's progress as an eventfd, so that a
+// consumer can wait on its ring from an epoll loop alongside sockets and
+// timers.
+//
+// A consumer about to sleep registers with PrepareToSleep(), polls fd() for
+// readability, and calls Acknowledge() once woken up. SignalAllWhenBlocking()
+// only writes to the eventfd when a consumer is registered and no wakeup is
+// already pending, a burst of publications thus costs a single write().
+// Alerting a barrier calls it as well to wake its consumer up.
+//
+// The eventfd is drained by Acknowledge(), a strategy instance should be
+// shared by a single sleeping consumer, usually the Sequencer's own
+// strategy obtained from Sequencer::wait_strategy().
+class EventFdStrategy {
+ public:
+  EventFdStrategy()
+      : fd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+        sleepers_(0),
+        signaled_(false) {
+    if (fd_ < 0)
+      throw std::system_error(errno, std::system_category(), "eventfd");
+  }
+
+  ~EventFdStrategy() { ::close(fd_); }
+
+  // Get the file descriptor becoming readable when the cursor advances.
+  //
+  // @return the eventfd, to be registered with EPOLLIN.
+  int fd() const { return fd_; }
+
+  // Register the caller as sleeping until `sequence` is published.
+  //
+  // @param sequence  the consumer is waiting for.
+  // @param cursor    sequencer's cursor.
+  // @return false if the sequence is already published and the caller must
+  //         not sleep, true if it must wait on fd() then Acknowledge().
+  bool PrepareToSleep(const int64_t& sequence, const Sequence& cursor) {
+    sleepers_.fetch_add(1);
+    // pairs with the fence in SignalAllWhenBlocking(), either we see the
+    // new cursor or the publisher sees us sleeping.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (cursor.sequence() >= sequence) {
+      sleepers_.fetch_sub(1);
+      return false;
+    }
+    return true;
+  }
+
+  // Unregister a consumer woken up after PrepareToSleep() and re-arm the
+  // eventfd for the next wakeup.
+  void Acknowledge() {
+    uint64_t value;
+    while (::read(fd_, &value, sizeof(value)) < 0 && errno == EINTR)
+      ;
+    sleepers_.fetch_sub(1);
+    signaled_.exchange(false, std::memory_order_acq_rel);
+  }
+
+  int64_t WaitFor(const int64_t& sequence, const Sequence& cursor,
+                  const std::vector<Sequence*>& dependents,
+                  const std::atomic<bool>& alerted) {
+    return WaitFor(sequence, cursor, dependents, alerted, -1);
+  }
+
+  template <class R, class P>
+  int64_t WaitFor(const int64_t& sequence, const Sequence& cursor,
+                  const std::vector<Sequence*>& dependents,
+                  const std::atomic<bool>& alerted,
+                  const std::chrono::duration<R, P>& timeout) {
+    // poll() counts milliseconds, round up rather than busy poll.
+    auto milliseconds =
+        std::chrono::duration_cast<std::chrono::milliseconds>(timeout);
+    if (milliseconds < timeout) milliseconds += std::chrono::milliseconds(1);
+    const int64_t count = milliseconds.count();
+    return WaitFor(sequence, cursor, dependents, alerted,
+                   count < 0 ? 0
+                             : count > std::numeric_limits<int>::max()
+                                   ? std::numeric_limits<int>::max()
+                                   : static_cast<int>(count));
+  }
+
+  void SignalAllWhenBlocking() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!sleepers_.load(std::memory_order_relaxed)) return;
+
+    if (!signaled_.exchange(true, std::memory_order_acq_rel)) {
+      const uint64_t value = 1;
+      while (::write(fd_, &value, sizeof(value)) < 0 && errno == EINTR)
+        ;
+    }
+  }
+
+ private:
+  int64_t WaitFor(const int64_t& sequence, const Sequence& cursor,
+                  const std::vector<Sequence*>& dependents,
+                  const std::atomic<bool>& alerted, int timeout) {
+    int64_t available_sequence = kInitialCursorValue;
+    // Like the BlockingStrategy, sleep on the cursor then spin on the
+    // dependents.
+    while ((available_sequence = cursor.sequence()) < sequence) {
+      if (alerted.load(std::memory_order_acquire)) return kAlertedSignal;
+
+      if (PrepareToSleep(sequence, cursor)) {
+        // pairs with the fence in SignalAllWhenBlocking(), an alert raised
+        // after the check above wakes us up.
+        if (alerted.load(std::memory_order_acquire)) {
+          Acknowledge();
+          return kAlertedSignal;
+        }
+
+        struct pollfd pfd = {fd_, POLLIN, 0};
+        int ready;
+        while ((ready = ::poll(&pfd, 1, timeout)) < 0 && errno == EINTR)
+          ;
+        const int err = errno;
+        Acknowledge();
+        if (ready < 0)
+          throw std::system_error(err, std::system_category(), "poll");
+        if (ready == 0) return kTimeoutSignal;
+      }
+    }
+
+    if (dependents.size()) {
+      while ((available_sequence = GetMinimumSequence(dependents)) < sequence) {
+        if (alerted.load(std::memory_order_acquire)) return kAlertedSignal;
+      }
+    }
+
+    return available_sequence;
+  }
+
+  const int fd_;
+  std::atomic<int64_t> sleepers_;
+  std::atomic<bool> signaled_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(EventFdStrategy);
+};
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_EVENTFD_WAIT_STRATEGY_H_ NOLINT
@@ -0,0 +1,188 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_FAN_IN_H_  // NOLINT
+#define DISRUPTOR_FAN_IN_H_  // NOLINT
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "disruptor/event_poller.h"
+#include "disruptor/sequence.h"
+#include "disruptor/wait_strategy.h"
+
+namespace disruptor {
+
+constexpr int64_t kDefaultFanInBatchSize = 1024L;
+
+// Order in which a FanInConsumer visits its rings.
+enum class FanInPriority {
+  // Every ring in turn, handing over at most its batch size per round, i.e.
+  // weighted-fair with weights given by the batch sizes.
+  kRoundRobin,
+  // A ring is only drained while every ring before it is empty, after a
+  // batch the rings are visited again from the first. A batch of a lower
+  // ring bounds the delay of an event overtaking it.
+  kStrict
+};
+
+// Consumer draining several sequencers from a single thread.
+//
+// Every ring is consumed through its own EventPoller, and thus its own
+// {@link Sequence} which must gate the matching sequencer. Rings are visited
+// in turn, each handing over at most `batch_size` events per round, and the
+// wait strategy is only applied once every ring was found empty.
+//
+// Rings may also be given priorities, e.g. control messages overtaking the
+// bulk of the events, by order with FanInPriority::kStrict or by weight
+// with a batch size per ring.
+//
+// @param <S> sequencer type of the rings.
+// @param <W> spinning wait strategy applied when all rings are idle.
+template <typename S, typename W = kDefaultWaitStrategy>
+class FanInConsumer {
+ public:
+  // Construct a consumer of a list of sequencers.
+  //
+  // @param sequencers  to consume, in the order they are drained.
+  // @param batch_size  maximum events handled per ring in a round.
+  FanInConsumer(const std::vector<S*>& sequencers,
+                int64_t batch_size = kDefaultFanInBatchSize)
+      : FanInConsumer(sequencers,
+                      std::vector<int64_t>(sequencers.size(), batch_size)) {}
+
+  // Construct a consumer of prioritized sequencers.
+  //
+  // @param sequencers   to consume, by decreasing priority.
+  // @param batch_sizes  maximum events handled per visit of each ring.
+  // @param priority     order in which the rings are visited.
+  // @throw std::invalid_argument if there is not one positive batch size per
+  //        ring.
+  FanInConsumer(const std::vector<S*>& sequencers,
+                const std::vector<int64_t>& batch_sizes,
+                FanInPriority priority = FanInPriority::kRoundRobin)
+      : batch_sizes_(batch_sizes), priority_(priority), alerted_(false) {
+    if (batch_sizes.size() != sequencers.size())
+      throw std::invalid_argument("one batch size per sequencer");
+    for (const int64_t& batch_size : batch_sizes)
+      if (batch_size <= 0)
+        throw std::invalid_argument("batch sizes must be positive");
+    for (S* sequencer : sequencers)
+      pollers_.emplace_back(
+          new EventPoller<S>(*sequencer, std::vector<Sequence*>()));
+  }
+
+  // Get the sequence tracking the progress on a ring.
+  //
+  // @param ring  index of the sequencer.
+  // @return the {@link Sequence} to register as gating sequence of the ring.
+  Sequence& sequence(size_t ring) { return pollers_[ring]->sequence(); }
+
+  // Get the progress reporter of a ring, for a consumer merging the rings
+  // itself instead of calling Drain().
+  //
+  // @param ring  index of the sequencer.
+  // @return the reporter publishing sequence(ring).
+  BatchProgress& progress(size_t ring) { return pollers_[ring]->progress(); }
+
+  // Get the number of rings consumed.
+  size_t size() const { return pollers_.size(); }
+
+  // Drain every ring once without blocking, or with a strict priority only
+  // the first ring with events.
+  //
+  // The handler is called as `handler(ring, event, sequence, end_of_batch)`
+  // with `ring` the index of the sequencer the event comes from.
+  //
+  // @param handler  called for each available event.
+  // @return the number of handled events.
+  template <typename H>
+  int64_t Drain(H&& handler) {
+    int64_t processed = 0;
+
+    for (size_t ring = 0; ring < pollers_.size(); ring++) {
+      RingHandler<H> ring_handler = {handler, ring, batch_sizes_[ring],
+                                     processed};
+      pollers_[ring]->Poll(ring_handler);
+      if (priority_ == FanInPriority::kStrict && processed) break;
+    }
+
+    return processed;
+  }
+
+  // Consume the rings until alerted, applying the wait strategy only when
+  // no ring had events.
+  //
+  // @param handler  called for each event, see Drain().
+  template <typename H>
+  void Run(H&& handler) {
+    int64_t idle_rounds = 0;
+
+    while (!alerted()) {
+      if (Drain(handler))
+        idle_rounds = 0;
+      else
+        wait_strategy_.Idle(idle_rounds++);
+    }
+  }
+
+  bool alerted() const { return alerted_.load(std::memory_order_acquire); }
+
+  void set_alerted(bool alert) {
+    alerted_.store(alert, std::memory_order_release);
+  }
+
+ private:
+  // Forward a ring's events to the user's handler, ending the batch after
+  // `remaining` events.
+  template <typename H>
+  struct RingHandler {
+    template <typename E>
+    bool operator()(E& event, const int64_t& sequence, bool end_of_batch) {
+      handler(ring, event, sequence, end_of_batch || remaining == 1);
+      processed++;
+      return --remaining > 0;
+    }
+
+    H& handler;
+    const size_t ring;
+    int64_t remaining;
+    int64_t& processed;
+  };
+
+  const std::vector<int64_t> batch_sizes_;
+  const FanInPriority priority_;
+  std::vector<std::unique_ptr<EventPoller<S>>> pollers_;
+  W wait_strategy_;
+  std::atomic<bool> alerted_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(FanInConsumer);
+};
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_FAN_IN_H_ NOLINT
@@ -0,0 +1,188 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_HUGE_PAGE_RING_BUFFER_H_  // NOLINT
+#define DISRUPTOR_HUGE_PAGE_RING_BUFFER_H_  // NOLINT
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <new>
+#include <system_error>
+
+#include "disruptor/ring_buffer.h"
+#include "disruptor/utils.h"
+
+namespace disruptor {
+
+// Size of the huge pages requested for the ring, the x86-64 and aarch64
+// default.
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+// Pages backing a huge page ring, from the best to the worst.
+enum class PageBacking {
+  // Reserved huge pages, mapped with MAP_HUGETLB.
+  kHugeTlb,
+  // Huge page aligned mapping advised with MADV_HUGEPAGE. The kernel may
+  // still back part of it with regular pages, AnonHugePages in
+  // /proc/self/smaps tells how much it did.
+  kTransparentHugePagesRequested,
+  // Regular pages, neither of the above was available.
+  kRegularPages
+};
+
+// Event storage tag selecting the RingBuffer backed by huge pages.
+//
+// @param <T> event type, default constructible.
+template <typename T>
+struct HugePages {};
+
+// Ring buffer stored in an anonymous mapping of huge pages, cutting the TLB
+// misses of walking a large ring.
+//
+// The storage comes from reserved huge pages when there are any, otherwise
+// from transparent huge pages and finally from regular pages. Every page is
+// faulted in and locked in memory by the constructor, so that the first lap
+// of the ring does not pay page faults; locking fails silently when the
+// RLIMIT_MEMLOCK limit is too low, see locked().
+//
+// @param <T> event type
+// @param <N> size of the ring
+template <typename T, size_t N>
+class RingBuffer<HugePages<T>, N> {
+ public:
+  using reference = T&;
+  using const_reference = const T&;
+
+  static_assert(((N > 0) && ((N & (~N + 1)) == N)),
+                "RingBuffer's size must be a positive power of 2");
+
+  // Map, pre-fault and lock the ring, then default-construct the events.
+  //
+  // @throw std::system_error if no memory could be mapped, or what T()
+  //        throws after destroying the events built so far and unmapping.
+  RingBuffer() : length_(RoundUp(sizeof(T) * N, kHugePageSize)) {
+    Map();
+    size_t i = 0;
+    try {
+      for (; i < N; i++) new (&events_[i]) T();
+    } catch (...) {
+      while (i) events_[--i].~T();
+      ::munmap(events_, length_);
+      throw;
+    }
+    locked_ = ::mlock(events_, length_) == 0;
+  }
+
+  ~RingBuffer() {
+    for (size_t i = 0; i < N; i++) events_[i].~T();
+    if (locked_) ::munlock(events_, length_);
+    ::munmap(events_, length_);
+  }
+
+  // Get the event for a given sequence in the RingBuffer.
+  //
+  // @param sequence for the event
+  // @return event reference at the specified sequence position.
+  T& operator[](const int64_t& sequence) { return events_[sequence & (N - 1)]; }
+
+  const T& operator[](const int64_t& sequence) const {
+    return events_[sequence & (N - 1)];
+  }
+
+  // Prefetch the event at a given sequence before reading it.
+  void Prefetch(const int64_t& sequence) const {
+    PrefetchObject<false>(&events_[sequence & (N - 1)]);
+  }
+
+  // Prefetch the event at a given sequence before writing it.
+  void PrefetchForWrite(const int64_t& sequence) {
+    PrefetchObject<true>(&events_[sequence & (N - 1)]);
+  }
+
+  // Get the pages backing the ring.
+  PageBacking backing() const { return backing_; }
+
+  // Is the ring locked in memory.
+  bool locked() const { return locked_; }
+
+  // Get the size of the mapping, a multiple of kHugePageSize.
+  size_t length() const { return length_; }
+
+ private:
+  static size_t RoundUp(size_t size, size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+  }
+
+  void Map() {
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE;
+
+    void* address = ::mmap(nullptr, length_, PROT_READ | PROT_WRITE,
+                           flags | MAP_HUGETLB, -1, 0);
+    if (address != MAP_FAILED) {
+      events_ = static_cast<T*>(address);
+      backing_ = PageBacking::kHugeTlb;
+      return;
+    }
+
+    // over-allocate to align the ring on a huge page, then trim.
+    const size_t padded = length_ + kHugePageSize;
+    address = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (address == MAP_FAILED)
+      throw std::system_error(errno, std::system_category(), "mmap");
+
+    const uintptr_t base = reinterpret_cast<uintptr_t>(address);
+    const uintptr_t aligned = RoundUp(base, kHugePageSize);
+    if (aligned > base) ::munmap(address, aligned - base);
+    if (aligned + length_ < base + padded)
+      ::munmap(reinterpret_cast<void*>(aligned + length_),
+               base + padded - aligned - length_);
+    events_ = reinterpret_cast<T*>(aligned);
+
+    backing_ = ::madvise(events_, length_, MADV_HUGEPAGE) == 0
+                   ? PageBacking::kTransparentHugePagesRequested
+                   : PageBacking::kRegularPages;
+
+    // fault every page in now that the advice can be honored.
+    const size_t page_size = ::sysconf(_SC_PAGESIZE);
+    volatile char* bytes = reinterpret_cast<volatile char*>(events_);
+    for (size_t offset = 0; offset < length_; offset += page_size)
+      bytes[offset] = 0;
+  }
+
+  const size_t length_;
+  T* events_;
+  PageBacking backing_;
+  bool locked_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(RingBuffer);
+};
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_HUGE_PAGE_RING_BUFFER_H_ NOLINT
@@ -0,0 +1,431 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_JOURNAL_H_  // NOLINT
+#define DISRUPTOR_JOURNAL_H_  // NOLINT
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "disruptor/sequence.h"
+#include "disruptor/utils.h"
+
+namespace disruptor {
+
+// Durability policy applied by the Journal after appending a batch.
+enum class SyncPolicy {
+  // Leave write-back to the kernel, survives a process crash only.
+  kNone,
+  // msync() every appended batch before returning.
+  kPerBatch,
+  // msync() dirty pages at most once every configured interval.
+  kInterval
+};
+
+constexpr uint64_t kJournalMagic = 0x4c4e524a44525344UL;  // "DSRDJRNL"
+constexpr size_t kDefaultJournalSegmentEvents = 1024 * 1024;
+using kDefaultJournalSyncInterval = std::chrono::milliseconds;
+constexpr int kDefaultJournalSyncIntervalValue = 10;
+
+// Header written at the beginning of every segment file. The rest of the
+// segment is a packed array of `capacity` events of `event_size` bytes, of
+// which the first `count` are committed.
+struct JournalHeader {
+  uint64_t magic;
+  uint64_t event_size;
+  uint64_t capacity;
+  std::atomic<uint64_t> count;
+  // padding, events start on their own cache line.
+  int64_t padding_[(CACHE_LINE_SIZE_IN_BYTES - 4 * sizeof(uint64_t)) / 8];
+};
+
+// A single memory-mapped, preallocated segment file of the journal.
+class JournalSegment {
+ public:
+  // Map the segment at `path`, creating and preallocating it if requested.
+  //
+  // @param path        of the segment file.
+  // @param event_size  size in bytes of a journaled event.
+  // @param capacity    number of events held by a new segment.
+  // @param writable    open for appending, creating the file if missing.
+  JournalSegment(const std::string& path, size_t event_size, size_t capacity,
+                 bool writable)
+      : fd_(-1), size_(0), data_(nullptr) {
+    fd_ = ::open(path.c_str(), writable ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+    if (fd_ < 0) throw std::system_error(errno, std::system_category(), path);
+
+    struct stat st;
+    if (::fstat(fd_, &st) < 0) Fail(path);
+
+    const bool created = (st.st_size == 0);
+    if (created) {
+      if (!writable) Fail(path, EINVAL);
+      size_ = sizeof(JournalHeader) + event_size * capacity;
+      if (::ftruncate(fd_, size_) < 0) Fail(path);
+      // Reserve the blocks now so appends never fault on a full disk.
+      const int err = ::posix_fallocate(fd_, 0, size_);
+      if (err && err != EINVAL && err != EOPNOTSUPP) Fail(path, err);
+    } else {
+      size_ = st.st_size;
+      if (size_ < sizeof(JournalHeader)) Fail(path, EINVAL);
+    }
+
+    const int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    // pre-fault the segment, appends then only touch resident pages.
+    if (writable) flags |= MAP_POPULATE;
+#endif
+    void* data = ::mmap(nullptr, size_, prot, flags, fd_, 0);
+    if (data == MAP_FAILED) Fail(path);
+    data_ = static_cast<char*>(data);
+
+    if (created) {
+      header()->magic = kJournalMagic;
+      header()->event_size = event_size;
+      header()->capacity = capacity;
+      header()->count.store(0, std::memory_order_release);
+    }
+
+    if (header()->magic != kJournalMagic ||
+        header()->event_size != event_size ||
+        size_ < sizeof(JournalHeader) + event_size * header()->capacity)
+      Fail(path, EINVAL);
+  }
+
+  ~JournalSegment() { Close(); }
+
+  JournalHeader* header() { return reinterpret_cast<JournalHeader*>(data_); }
+
+  char* events() { return data_ + sizeof(JournalHeader); }
+
+  // Flush the pages covering [offset, offset + length) of the event area.
+  //
+  // @throw std::system_error if the pages cannot be written back.
+  void Sync(size_t offset, size_t length) {
+    const size_t page = ::sysconf(_SC_PAGESIZE);
+    const size_t begin = sizeof(JournalHeader) + offset;
+    const size_t aligned = begin - (begin % page);
+    if (::msync(data_ + aligned, begin + length - aligned, MS_SYNC) < 0)
+      throw std::system_error(errno, std::system_category(), "msync");
+  }
+
+  // Flush the header, and the committed count it holds.
+  //
+  // @throw std::system_error if the header cannot be written back.
+  void SyncHeader() {
+    if (::msync(data_, sizeof(JournalHeader), MS_SYNC) < 0)
+      throw std::system_error(errno, std::system_category(), "msync");
+  }
+
+ private:
+  void Close() {
+    if (data_) ::munmap(data_, size_);
+    if (fd_ >= 0) ::close(fd_);
+  }
+
+  void Fail(const std::string& path, int err = errno) {
+    Close();
+    throw std::system_error(err, std::system_category(), path);
+  }
+
+  int fd_;
+  size_t size_;
+  char* data_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(JournalSegment);
+};
+
+// Path of the n-th segment of the journal rooted at `path`.
+static inline std::string JournalSegmentPath(const std::string& path,
+                                             size_t index) {
+  char suffix[16];
+  std::snprintf(suffix, sizeof(suffix), ".%06zu", index);
+  return path + suffix;
+}
+
+static inline bool JournalSegmentExists(const std::string& path,
+                                        size_t index) {
+  struct stat st;
+  return ::stat(JournalSegmentPath(path, index).c_str(), &st) == 0;
+}
+
+// Append-only journal of events stored in a series of memory-mapped segment
+// files named `<path>.000000`, `<path>.000001`, ...
+//
+// Published ranges are copied into the mapping in one pass per batch and
+// committed by bumping the segment's event count, there is no syscall on the
+// append path unless the SyncPolicy asks for one. Under kPerBatch and
+// kInterval the count is only bumped by Sync(), once the events it covers
+// are on disk. Opening an existing journal resumes appending after the last
+// committed event.
+//
+// @param <T> event type, must be trivially copyable.
+template <typename T>
+class Journal {
+ public:
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Journal requires a trivially copyable event type");
+
+  // Open or create a journal.
+  //
+  // @param path            prefix of the segment files.
+  // @param segment_events  events per segment, used for new segments.
+  // @param policy          when to flush appended events to disk.
+  // @param interval        minimal delay between flushes for kInterval.
+  // @throw std::invalid_argument if segment_events is 0.
+  template <class R = int64_t, class P = std::milli>
+  Journal(const std::string& path,
+          size_t segment_events = kDefaultJournalSegmentEvents,
+          SyncPolicy policy = SyncPolicy::kNone,
+          const std::chrono::duration<R, P>& interval =
+              kDefaultJournalSyncInterval(kDefaultJournalSyncIntervalValue))
+      : path_(path),
+        segment_events_(segment_events),
+        policy_(policy),
+        interval_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            interval)),
+        index_(0),
+        count_(0),
+        synced_(0),
+        last_sync_(std::chrono::steady_clock::now()) {
+    if (segment_events_ == 0)
+      throw std::invalid_argument("a journal segment holds no event");
+    while (JournalSegmentExists(path_, index_ + 1)) ++index_;
+    Open();
+    if (count_ == capacity_) Roll();
+  }
+
+  // Flush the remaining events, call Sync() first to observe its errors.
+  ~Journal() {
+    if (policy_ == SyncPolicy::kNone) return;
+    try {
+      Sync();
+    } catch (const std::system_error&) {
+    }
+  }
+
+  // Append a batch of contiguous events.
+  //
+  // @param events  to append.
+  // @param count   number of events.
+  void Append(const T* events, size_t count) {
+    while (count) {
+      const size_t length = std::min(count, capacity_ - count_);
+      std::memcpy(At(count_), events, length * sizeof(T));
+      Commit(length);
+      events += length;
+      count -= length;
+    }
+    ApplySyncPolicy();
+  }
+
+  // Append the published range [first, last] of a Sequencer's ring.
+  //
+  // @param sequencer  holding the events.
+  // @param first      first sequence of the range.
+  // @param last       last sequence of the range, inclusive.
+  template <typename S>
+  void Append(S& sequencer, const int64_t& first, const int64_t& last) {
+    int64_t sequence = first;
+    while (sequence <= last) {
+      const int64_t end =
+          std::min<int64_t>(last + 1L, sequence + (capacity_ - count_));
+      char* destination = At(count_);
+      for (int64_t i = sequence; i < end; i++, destination += sizeof(T))
+        std::memcpy(destination, &sequencer[i], sizeof(T));
+      Commit(end - sequence);
+      sequence = end;
+    }
+    ApplySyncPolicy();
+  }
+
+  // Journaling consumer: append every published range until the barrier is
+  // alerted, advancing `sequence` once a range is in the journal.
+  //
+  // @param sequencer  holding the events.
+  // @param barrier    gating this consumer.
+  // @param sequence   of this consumer, to be used as gating sequence.
+  template <typename S, typename B>
+  void Consume(S& sequencer, B& barrier, Sequence& sequence) {
+    int64_t next_sequence = sequence.sequence() + 1L;
+    while (true) {
+      const int64_t available = (policy_ == SyncPolicy::kInterval)
+                                    ? barrier.WaitFor(next_sequence, interval_)
+                                    : barrier.WaitFor(next_sequence);
+      if (available == kAlertedSignal) break;
+      if (available == kTimeoutSignal) {
+        ApplySyncPolicy();
+        continue;
+      }
+
+      Append(sequencer, next_sequence, available);
+      sequence.set_sequence(available);
+      next_sequence = available + 1L;
+    }
+
+    if (policy_ != SyncPolicy::kNone) Sync();
+  }
+
+  // Flush every appended event of the current segment to disk, then commit
+  // them in the segment's count.
+  //
+  // @throw std::system_error if the segment cannot be written back.
+  void Sync() {
+    if (synced_ < count_) {
+      segment_->Sync(synced_ * sizeof(T), (count_ - synced_) * sizeof(T));
+      segment_->header()->count.store(count_, std::memory_order_release);
+      segment_->SyncHeader();
+    }
+    synced_ = count_;
+    last_sync_ = std::chrono::steady_clock::now();
+  }
+
+ private:
+  char* At(size_t index) { return segment_->events() + index * sizeof(T); }
+
+  void Commit(size_t length) {
+    count_ += length;
+    // Sync() commits the events once they are on disk, write-back must not
+    // persist a count covering pages it did not write yet.
+    if (policy_ == SyncPolicy::kNone)
+      segment_->header()->count.store(count_, std::memory_order_release);
+    if (count_ == capacity_) Roll();
+  }
+
+  void ApplySyncPolicy() {
+    switch (policy_) {
+      case SyncPolicy::kNone:
+        break;
+      case SyncPolicy::kPerBatch:
+        Sync();
+        break;
+      case SyncPolicy::kInterval:
+        if (std::chrono::steady_clock::now() - last_sync_ >= interval_) Sync();
+        break;
+    }
+  }
+
+  void Open() {
+    segment_.reset(new JournalSegment(JournalSegmentPath(path_, index_),
+                                      sizeof(T), segment_events_, true));
+    capacity_ = segment_->header()->capacity;
+    count_ = segment_->header()->count.load();
+    synced_ = count_;
+  }
+
+  // Close the full segment and move on to the next one.
+  void Roll() {
+    if (policy_ != SyncPolicy::kNone) Sync();
+    ++index_;
+    Open();
+  }
+
+  const std::string path_;
+  const size_t segment_events_;
+  const SyncPolicy policy_;
+  const std::chrono::nanoseconds interval_;
+
+  std::unique_ptr<JournalSegment> segment_;
+  size_t index_;
+  size_t capacity_;
+  size_t count_;
+  size_t synced_;
+  std::chrono::steady_clock::time_point last_sync_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(Journal);
+};
+
+// Replay producer streaming a journal back into a Sequencer's ring.
+//
+// @param <T> event type, must match the journal's.
+template <typename T>
+class JournalReader {
+ public:
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Journal requires a trivially copyable event type");
+
+  // @param path  prefix of the segment files.
+  JournalReader(const std::string& path) : path_(path) {}
+
+  // Publish every committed event of the journal, in order, claiming up to
+  // `batch_size` sequences at once.
+  //
+  // @param sequencer   to publish into.
+  // @param batch_size  sequences claimed per batch, at most the ring size.
+  // @return the number of replayed events.
+  // @throw std::invalid_argument if batch_size is 0 or exceeds the ring.
+  template <typename S>
+  int64_t Replay(S& sequencer, size_t batch_size = 64) {
+    if (batch_size == 0 || batch_size > S::kRingSize)
+      throw std::invalid_argument("invalid replay batch size");
+
+    int64_t replayed = 0;
+
+    for (size_t index = 0; JournalSegmentExists(path_, index); index++) {
+      JournalSegment segment(JournalSegmentPath(path_, index), sizeof(T), 0,
+                             false);
+      const size_t count = segment.header()->count.load(
+          std::memory_order_acquire);
+      const char* source = segment.events();
+
+      size_t offset = 0;
+      while (offset < count) {
+        const size_t delta = std::min(batch_size, count - offset);
+        const int64_t last = sequencer.Claim(delta);
+        for (int64_t sequence = last - delta + 1; sequence <= last;
+             sequence++, source += sizeof(T))
+          std::memcpy(&sequencer[sequence], source, sizeof(T));
+        sequencer.Publish(last, delta);
+        offset += delta;
+      }
+      replayed += count;
+    }
+
+    return replayed;
+  }
+
+ private:
+  const std::string path_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(JournalReader);
+};
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_JOURNAL_H_ NOLINT
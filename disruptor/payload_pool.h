@@ -0,0 +1,259 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_PAYLOAD_POOL_H_  // NOLINT
+#define DISRUPTOR_PAYLOAD_POOL_H_  // NOLINT
+
+#include <sys/mman.h>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include "disruptor/ring_buffer.h"
+#include "disruptor/sequence.h"
+#include "disruptor/utils.h"
+
+namespace disruptor {
+
+// Block index marking the end of a free list.
+constexpr uint32_t kNoBlock = UINT32_MAX;
+
+// Block of a PayloadPool, stored in an event in place of an owning pointer.
+struct Payload {
+  Payload() : data(nullptr), size_class(0), block(kNoBlock) {}
+
+  // Is there no block, e.g. the pool was exhausted.
+  bool empty() const { return data == nullptr; }
+
+  void* data;
+  uint32_t size_class;
+  uint32_t block;
+};
+
+// Size and number of blocks of a size class.
+struct SizeClass {
+  size_t block_size;
+  size_t blocks;
+};
+
+// Fixed slab of equal blocks with a lock-free free list.
+//
+// The head of the list packs the index of the first free block with a tag
+// incremented on every update, so that a block popped and pushed back
+// between the load and the compare-and-swap of a pop does not corrupt the
+// list.
+class PayloadSlab {
+ public:
+  // Map and pre-fault the blocks, then chain them in the free list.
+  //
+  // @throw std::system_error if the slab could not be mapped.
+  PayloadSlab(const SizeClass& size_class)
+      : block_size_(size_class.block_size),
+        stride_(RoundUp(size_class.block_size, kCacheLinePadding)),
+        blocks_(size_class.blocks),
+        length_(stride_ * blocks_),
+        next_(new std::atomic<uint32_t>[blocks_]),
+        head_(0) {
+    void* address =
+        ::mmap(nullptr, length_, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (address == MAP_FAILED)
+      throw std::system_error(errno, std::system_category(), "mmap");
+    base_ = static_cast<char*>(address);
+
+    for (size_t i = 0; i < blocks_; i++)
+      next_[i].store(i + 1 < blocks_ ? i + 1 : kNoBlock,
+                     std::memory_order_relaxed);
+  }
+
+  ~PayloadSlab() { ::munmap(base_, length_); }
+
+  // Pop a free block.
+  //
+  // @return the index of the block, kNoBlock if the slab is exhausted.
+  uint32_t Pop() {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    while (true) {
+      const uint32_t block = Index(head);
+      if (block == kNoBlock) return kNoBlock;
+
+      const uint64_t next =
+          Pack(Tag(head) + 1, next_[block].load(std::memory_order_relaxed));
+      if (head_.compare_exchange_weak(head, next, std::memory_order_acquire,
+                                      std::memory_order_acquire))
+        return block;
+    }
+  }
+
+  // Push a block back in the free list.
+  //
+  // @param block index returned by Pop().
+  void Push(uint32_t block) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    while (true) {
+      next_[block].store(Index(head), std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(head, Pack(Tag(head) + 1, block),
+                                      std::memory_order_release,
+                                      std::memory_order_relaxed))
+        return;
+    }
+  }
+
+  // Get the storage of a block.
+  void* data(uint32_t block) const { return base_ + block * stride_; }
+
+  // Get the usable size of every block.
+  size_t block_size() const { return block_size_; }
+
+ private:
+  static size_t RoundUp(size_t size, size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+  }
+
+  static uint32_t Index(uint64_t head) { return head & UINT32_MAX; }
+  static uint32_t Tag(uint64_t head) { return head >> 32; }
+  static uint64_t Pack(uint32_t tag, uint32_t index) {
+    return (static_cast<uint64_t>(tag) << 32) | index;
+  }
+
+  const size_t block_size_;
+  const size_t stride_;
+  const size_t blocks_;
+  const size_t length_;
+  char* base_;
+  std::unique_ptr<std::atomic<uint32_t>[]> next_;
+  std::atomic<uint64_t> head_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(PayloadSlab);
+};
+
+// Pool of payloads too large for the slots of a ring of N events, e.g.
+// buffers of kilobytes to megabytes referenced by the events.
+//
+// Every slab is mapped and faulted in by the constructor, allocating and
+// releasing a payload are a pop and a push on the lock-free free list of
+// its size class, without any system call nor lock.
+//
+// Publishers attach each payload to the sequence of its event, and the
+// last gating consumer reclaims every payload attached up to the sequence
+// it processed, before publishing its own sequence. Payloads go back to
+// the pool once consumed, without being handed to the allocator of another
+// thread.
+//
+// @param <N> size of the ring the payloads are attached to.
+template <size_t N = kDefaultRingBufferSize>
+class PayloadPool {
+ public:
+  // Construct a pool with one slab per size class.
+  //
+  // @param size_classes by increasing block size.
+  // @throw std::invalid_argument if the classes are not increasing or a
+  //        class has no block.
+  // @throw std::system_error if a slab could not be mapped.
+  PayloadPool(const std::vector<SizeClass>& size_classes)
+      : reclaimed_sequence_(kInitialCursorValue) {
+    size_t previous = 0;
+    for (const SizeClass& size_class : size_classes) {
+      if (size_class.block_size <= previous)
+        throw std::invalid_argument("size classes must be increasing");
+      if (size_class.blocks == 0 || size_class.blocks >= kNoBlock)
+        throw std::invalid_argument("invalid number of blocks");
+      previous = size_class.block_size;
+      slabs_.emplace_back(new PayloadSlab(size_class));
+    }
+  }
+
+  static_assert(((N > 0) && ((N & (~N + 1)) == N)),
+                "RingBuffer's size must be a positive power of 2");
+
+  // Allocate a payload from the smallest size class with a free block of at
+  // least `size` bytes.
+  //
+  // @param size of the payload.
+  // @return the payload, empty if every fitting class is exhausted.
+  Payload Allocate(size_t size) {
+    Payload payload;
+    for (uint32_t i = 0; i < slabs_.size(); i++) {
+      if (slabs_[i]->block_size() < size) continue;
+      const uint32_t block = slabs_[i]->Pop();
+      if (block == kNoBlock) continue;
+
+      payload.data = slabs_[i]->data(block);
+      payload.size_class = i;
+      payload.block = block;
+      break;
+    }
+    return payload;
+  }
+
+  // Give a payload back to the pool.
+  //
+  // @param payload returned by Allocate().
+  void Release(const Payload& payload) {
+    if (!payload.empty()) slabs_[payload.size_class]->Push(payload.block);
+  }
+
+  // Hand a payload over to the consumers with the event at `sequence`,
+  // before publishing it.
+  //
+  // @param sequence claimed by the publisher.
+  // @param payload  referenced by the event.
+  void Attach(const int64_t& sequence, const Payload& payload) {
+    attached_[sequence & (N - 1)] = payload;
+  }
+
+  // Release every payload attached up to `sequence`, called by the last
+  // gating consumer before it publishes its sequence.
+  //
+  // @param sequence processed by the consumer.
+  void Reclaim(const int64_t& sequence) {
+    for (int64_t i = reclaimed_sequence_ + 1; i <= sequence; i++) {
+      Payload& payload = attached_[i & (N - 1)];
+      Release(payload);
+      payload = Payload();
+    }
+    reclaimed_sequence_ = sequence;
+  }
+
+  // Get the number of size classes.
+  size_t size() const { return slabs_.size(); }
+
+ private:
+  std::vector<std::unique_ptr<PayloadSlab>> slabs_;
+  std::array<Payload, N> attached_;
+  int64_t reclaimed_sequence_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(PayloadPool);
+};
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_PAYLOAD_POOL_H_ NOLINT
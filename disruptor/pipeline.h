@@ -0,0 +1,295 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_PIPELINE_H_  // NOLINT
+#define DISRUPTOR_PIPELINE_H_  // NOLINT
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "disruptor/ring_buffer.h"
+#include "disruptor/sequence.h"
+#include "disruptor/utils.h"
+
+namespace disruptor {
+
+// A stage of a Pipeline, consuming events with a handler of type H after
+// the upstream stages whose indices are listed in Dependencies. A stage
+// without dependencies consumes directly behind the sequencer's cursor.
+//
+// @param <H> handler type, called as `handler(event, sequence, end_of_batch)`
+// @param <Dependencies> indices of upstream stages, all smaller than the
+//                       index of this stage.
+template <typename H, size_t... Dependencies>
+struct Stage {
+  using handler_type = H;
+};
+
+// used internally, compile-time queries on the stages' dependencies.
+constexpr bool ContainsIndex(size_t) { return false; }
+
+template <typename... Ts>
+constexpr bool ContainsIndex(size_t index, size_t head, Ts... tail) {
+  return index == head || ContainsIndex(index, tail...);
+}
+
+constexpr bool AllLessThan(size_t) { return true; }
+
+template <typename... Ts>
+constexpr bool AllLessThan(size_t index, size_t head, Ts... tail) {
+  return head < index && AllLessThan(index, tail...);
+}
+
+template <size_t I, typename... Stages>
+struct ValidDependencies {
+  static constexpr bool value = true;
+};
+
+template <size_t I, typename H, size_t... Ds, typename... Stages>
+struct ValidDependencies<I, Stage<H, Ds...>, Stages...> {
+  static constexpr bool value =
+      AllLessThan(I, Ds...) && ValidDependencies<I + 1, Stages...>::value;
+};
+
+template <typename... Stages>
+struct AnyStageDependsOn {
+  static constexpr bool value(size_t) { return false; }
+};
+
+template <typename H, size_t... Ds, typename... Stages>
+struct AnyStageDependsOn<Stage<H, Ds...>, Stages...> {
+  static constexpr bool value(size_t index) {
+    return ContainsIndex(index, Ds...) ||
+           AnyStageDependsOn<Stages...>::value(index);
+  }
+};
+
+// Consumer topology declared at compile time.
+//
+// Stages are listed in topological order, each one only depending on
+// previous stages, which the compiler checks. The dependency graph, the
+// handlers' types and the gating set, stages no other stage depends on, are
+// all known at compile time: each stage runs a loop calling its handler
+// directly and computing its barrier over a fixed set of sequences, there
+// is no vector of dependents, runtime strategy lookup or std::function on
+// the hot path.
+//
+//   using Topology = Pipeline<MySequencer, BusySpinStrategy,
+//                             Stage<Journaler>,          // 0
+//                             Stage<Replicator>,         // 1
+//                             Stage<BusinessLogic, 0, 1> // 2
+//                             >;
+//
+// @param <S> sequencer type, exposing cursor(), operator[] and
+//            set_gating_sequences().
+// @param <W> spinning wait strategy applied when a stage is idle, each
+//            stage owns one.
+// @param <Stages> the stages, see Stage.
+template <typename S, typename W, typename... Stages>
+class Pipeline {
+ public:
+  static constexpr size_t kStages = sizeof...(Stages);
+
+  static_assert(kStages > 0, "Pipeline requires at least one stage");
+  static_assert(ValidDependencies<0, Stages...>::value,
+                "a stage may only depend on previous stages");
+
+  template <size_t I>
+  using stage_type =
+      typename std::tuple_element<I, std::tuple<Stages...>>::type;
+
+  // Is the stage gating the publishers, i.e. no stage depends on it.
+  //
+  // @param index of the stage.
+  static constexpr bool IsGating(size_t index) {
+    return !AnyStageDependsOn<Stages...>::value(index);
+  }
+
+  // Construct the pipeline and register its gating stages on the
+  // sequencer.
+  //
+  // @param sequencer  to consume events from.
+  // @param handlers   of every stage, in the stages' order.
+  Pipeline(S& sequencer, typename Stages::handler_type&... handlers)
+      : sequencer_(sequencer),
+        handlers_(handlers...),
+        prefetch_distance_(kNoPrefetch) {
+    for (std::atomic<bool>& alerted : alerted_) alerted.store(false);
+    std::vector<Sequence*> gating_sequences;
+    for (size_t i = 0; i < kStages; i++)
+      if (IsGating(i)) gating_sequences.push_back(&sequences_[i]);
+    sequencer_.set_gating_sequences(gating_sequences);
+  }
+
+  ~Pipeline() { Halt(); }
+
+  // Get the sequence of a stage.
+  template <size_t I>
+  Sequence& sequence() {
+    static_assert(I < kStages, "no such stage");
+    return sequences_[I];
+  }
+
+  // Prefetch, in every stage, the event `distance` sequences ahead of the
+  // one handed to the handler. Set before Start().
+  //
+  // @param distance in sequences, kNoPrefetch to disable.
+  void set_prefetch_distance(int64_t distance) {
+    prefetch_distance_ = distance;
+  }
+
+  // Run the loop of stage I on the calling thread until halted.
+  template <size_t I>
+  void Run() {
+    static_assert(I < kStages, "no such stage");
+    auto& handler = std::get<I>(handlers_);
+    Sequence& sequence = sequences_[I];
+    const stage_type<I>* stage = nullptr;
+
+    int64_t next_sequence = sequence.sequence() + 1L;
+    int64_t idle_rounds = 0;
+    while (true) {
+      const int64_t available_sequence = GetAvailableSequence(stage);
+      if (available_sequence < next_sequence) {
+        if (alerted_[I].load(std::memory_order_acquire)) {
+          // events published before the alert are visible once it is.
+          if (GetAvailableSequence(stage) < next_sequence) return;
+          continue;
+        }
+        wait_strategies_[I].Idle(idle_rounds++);
+        continue;
+      }
+
+      idle_rounds = 0;
+      for (; next_sequence <= available_sequence; next_sequence++) {
+        if (prefetch_distance_ != kNoPrefetch)
+          sequencer_.Prefetch(next_sequence + prefetch_distance_);
+        handler(sequencer_[next_sequence], next_sequence,
+                next_sequence == available_sequence);
+      }
+      sequence.set_sequence(available_sequence);
+    }
+  }
+
+  // Warm the whole topology up before going live: run every stage on its
+  // thread, publish `cycles` synthetic events through them, then halt the
+  // stages and reset the sequencer and the stages' sequences. Start() the
+  // pipeline afterwards.
+  //
+  // @param cycles  number of synthetic events to publish.
+  // @param filler  called as `filler(event)` for each synthetic event, which
+  //                it must mark as such for the handlers.
+  template <typename F>
+  void WarmUp(int64_t cycles, F&& filler) {
+    Start();
+    sequencer_.WarmUp(cycles, filler);
+    Halt();
+    sequencer_.Reset();
+    Reset();
+  }
+
+  // Move every stage's sequence back to its initial state. The stages must
+  // be halted.
+  void Reset() {
+    for (Sequence& sequence : sequences_)
+      sequence.set_sequence(kInitialCursorValue);
+  }
+
+  // Launch one thread per stage.
+  //
+  // @throw std::logic_error if the stages are already running.
+  void Start() {
+    if (!threads_.empty())
+      throw std::logic_error("pipeline already started");
+    for (std::atomic<bool>& alerted : alerted_)
+      alerted.store(false, std::memory_order_release);
+    StartFrom<0>();
+  }
+
+  // Stop the stages in their topological order, and join the threads
+  // launched by Start(). A stage is only stopped once every stage it depends
+  // on has stopped, and returns once it has no more available events, so
+  // every event published before the call goes through every stage.
+  // Publishers must be stopped first.
+  void Halt() {
+    for (size_t i = 0; i < kStages; i++) {
+      alerted_[i].store(true, std::memory_order_release);
+      if (i < threads_.size()) threads_[i].join();
+    }
+    threads_.clear();
+  }
+
+ private:
+  template <size_t I>
+  typename std::enable_if<(I < kStages)>::type StartFrom() {
+    threads_.emplace_back([this]() { Run<I>(); });
+    StartFrom<I + 1>();
+  }
+
+  template <size_t I>
+  typename std::enable_if<(I == kStages)>::type StartFrom() {}
+
+  // Stage without dependencies, gated on the cursor.
+  template <typename H>
+  int64_t GetAvailableSequence(const Stage<H>*) const {
+    return sequencer_.cursor().sequence();
+  }
+
+  template <typename H, size_t D, size_t... Ds>
+  int64_t GetAvailableSequence(const Stage<H, D, Ds...>*) const {
+    return GetMinimumSequence(sequences_[D].sequence(), Ds...);
+  }
+
+  int64_t GetMinimumSequence(int64_t minimum) const { return minimum; }
+
+  template <typename... Ts>
+  int64_t GetMinimumSequence(int64_t minimum, size_t head, Ts... tail) const {
+    const int64_t sequence = sequences_[head].sequence();
+    return GetMinimumSequence(minimum < sequence ? minimum : sequence,
+                              tail...);
+  }
+
+  S& sequencer_;
+  std::tuple<typename Stages::handler_type&...> handlers_;
+  Sequence sequences_[kStages];
+  // one per stage, strategies may keep state across idle rounds.
+  W wait_strategies_[kStages];
+  int64_t prefetch_distance_;
+  std::atomic<bool> alerted_[kStages];
+  std::vector<std::thread> threads_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(Pipeline);
+};
+
+template <typename S, typename W, typename... Stages>
+constexpr size_t Pipeline<S, W, Stages...>::kStages;
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_PIPELINE_H_ NOLINT
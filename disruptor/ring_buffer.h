@@ -27,19 +27,64 @@
 #define DISRUPTOR_RING_BUFFER_H_  // NOLINT
 
 #include <array>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
 #include "utils.h"
 
 namespace disruptor {
 
 constexpr size_t kDefaultRingBufferSize = 1024;
+// Prefetch distance disabling prefetching.
+constexpr int64_t kNoPrefetch = 0;
+
+// used internally, is F a factory of events rather than an array of them.
+template <typename T, size_t N, typename F>
+using EnableIfEventFactory = typename std::enable_if<
+    !std::is_same<typename std::decay<F>::type, std::array<T, N>>::value>::type;
+
+// used internally, see EmplaceEvent().
+template <typename T, typename... Args>
+inline void EmplaceEvent(std::true_type, T& event, Args&&... args) {
+  event.~T();
+  new (&event) T(std::forward<Args>(args)...);
+}
+
+template <typename T, typename... Args>
+inline void EmplaceEvent(std::false_type, T& event, Args&&... args) {
+  event = T(std::forward<Args>(args)...);
+}
+
+// Construct a new event in place of `event`, whose previous value is
+// destroyed. Falls back to a move assignment from a temporary when the
+// construction may throw, which would leave `event` destroyed.
+//
+// @param event to replace.
+// @param args  of the constructor of the new event.
+template <typename T, typename... Args>
+inline void EmplaceEvent(T& event, Args&&... args) {
+  EmplaceEvent(std::integral_constant<
+                   bool, std::is_nothrow_constructible<T, Args&&...>::value>(),
+               event, std::forward<Args>(args)...);
+}
 
 // Ring buffer implemented with a fixed array.
 //
+// Events are constructed once with the ring, either copied from an array
+// or built in place by a factory, and need neither be default constructible
+// nor copyable. Publishers replace them with Sequencer::Emplace() and the
+// last consumer may move them out.
+//
 // @param <T> event type
 // @param <N> size of the ring
 template <typename T, size_t N = kDefaultRingBufferSize>
 class RingBuffer {
  public:
+  using reference = T&;
+  using const_reference = const T&;
+
   // Construct a RingBuffer with the full option set.
   //
   // @param event_factory to instance new entries for filling the RingBuffer.
@@ -48,7 +93,22 @@ class RingBuffer {
   // entries in the ring.
   // @param wait_strategy_option waiting strategy employed by
   // processors_to_track waiting in entries becoming available.
-  RingBuffer(const std::array<T, N>& events) : events_(events) {}
+  RingBuffer(const std::array<T, N>& events) {
+    Construct([&events](size_t i) -> const T& { return events[i]; });
+  }
+
+  // Construct a RingBuffer building every event in place.
+  //
+  // @param factory called as `factory(i)` for the event at index i, returns
+  //                the event or the single argument of its constructor.
+  template <typename F, typename = EnableIfEventFactory<T, N, F>>
+  explicit RingBuffer(F&& factory) {
+    Construct(factory);
+  }
+
+  ~RingBuffer() {
+    for (size_t i = 0; i < N; i++) event(i).~T();
+  }
 
   static_assert(((N > 0) && ((N & (~N + 1)) == N)),
                 "RingBuffer's size must be a positive power of 2");
@@ -57,14 +117,45 @@ class RingBuffer {
   //
   // @param sequence for the event
   // @return event reference at the specified sequence position.
-  T& operator[](const int64_t& sequence) { return events_[sequence & (N - 1)]; }
+  T& operator[](const int64_t& sequence) { return event(sequence & (N - 1)); }
 
   const T& operator[](const int64_t& sequence) const {
-    return events_[sequence & (N - 1)];
+    return event(sequence & (N - 1));
+  }
+
+  // Prefetch the event at a given sequence before reading it.
+  //
+  // @param sequence for the event.
+  void Prefetch(const int64_t& sequence) const {
+    PrefetchObject<false>(&event(sequence & (N - 1)));
+  }
+
+  // Prefetch the event at a given sequence before writing it.
+  //
+  // @param sequence for the event.
+  void PrefetchForWrite(const int64_t& sequence) {
+    PrefetchObject<true>(&event(sequence & (N - 1)));
   }
 
  private:
-  std::array<T, N> events_;
+  template <typename F>
+  void Construct(F&& factory) {
+    size_t i = 0;
+    try {
+      for (; i < N; i++) new (&events_[i]) T(factory(i));
+    } catch (...) {
+      while (i > 0) event(--i).~T();
+      throw;
+    }
+  }
+
+  T& event(size_t index) { return *reinterpret_cast<T*>(&events_[index]); }
+
+  const T& event(size_t index) const {
+    return *reinterpret_cast<const T*>(&events_[index]);
+  }
+
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type events_[N];
 
   DISALLOW_COPY_MOVE_AND_ASSIGN(RingBuffer);
 };
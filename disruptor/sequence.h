@@ -23,17 +23,17 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
 // THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
-#ifndef CACHE_LINE_SIZE_IN_BYTES     // NOLINT
-#define CACHE_LINE_SIZE_IN_BYTES 64  // NOLINT
-#endif                               // NOLINT
 #define ATOMIC_SEQUENCE_PADDING_LENGTH \
-  (CACHE_LINE_SIZE_IN_BYTES - sizeof(std::atomic<int64_t>)) / 8
-#define SEQUENCE_PADDING_LENGTH (CACHE_LINE_SIZE_IN_BYTES - sizeof(int64_t)) / 8
+  (kCacheLinePadding - sizeof(std::atomic<int64_t>)) / 8
+#define SEQUENCE_PADDING_LENGTH (kCacheLinePadding - sizeof(int64_t)) / 8
 
 #ifndef DISRUPTOR_SEQUENCE_H_  // NOLINT
 #define DISRUPTOR_SEQUENCE_H_  // NOLINT
 
 #include <atomic>
+#include <climits>
+#include <cstdint>
+#include <vector>
 
 #include "disruptor/utils.h"
 
@@ -58,24 +58,36 @@ class Sequence {
   //
   // @return the current value.
   int64_t sequence() const {
-    return sequence_.load(std::memory_order::memory_order_acquire);
+    return sequence_.load(std::memory_order_acquire);
   }
 
   // Set the current value of the {@link Sequence}.
   //
   // @param the value to which the {@link Sequence} will be set.
   void set_sequence(int64_t value) {
-    sequence_.store(value, std::memory_order::memory_order_release);
+    sequence_.store(value, std::memory_order_release);
   }
 
   // Increment and return the value of the {@link Sequence}.
   //
+  // A counter only handing out unique values, e.g. a claim counter, does not
+  // publish anything and can use std::memory_order_relaxed.
+  //
   // @param increment the {@link Sequence}.
+  // @param order     of the read-modify-write operation.
   // @return the new value incremented.
-  int64_t IncrementAndGet(const int64_t& increment) {
-    return sequence_.fetch_add(increment,
-                               std::memory_order::memory_order_release) +
-           increment;
+  int64_t IncrementAndGet(const int64_t& increment,
+                          std::memory_order order = std::memory_order_release) {
+    return sequence_.fetch_add(increment, order) + increment;
+  }
+
+  // Set the {@link Sequence} to `value` if it still holds `expected`.
+  //
+  // @param expected value of the sequence.
+  // @param value    to set.
+  // @return true if the sequence was set.
+  bool CompareAndSet(int64_t expected, int64_t value) {
+    return sequence_.compare_exchange_strong(expected, value);
   }
 
  private:
@@ -34,38 +34,86 @@
 
 namespace disruptor {
 
+// Barrier of a single consumer, waiting for the cursor and its upstream
+// consumers' {@link Sequence}s.
+//
+// The barrier remembers the highest sequence it saw available: a consumer
+// asking for a sequence it already knows about returns immediately without
+// loading the producer's cursor line nor the dependents' lines. Once
+// alerted, the barrier no longer hands out known sequences and defers to
+// its wait strategy.
 template <typename W = kDefaultWaitStrategy>
 class SequenceBarrier {
  public:
+  // Construct a barrier with its own wait strategy.
   SequenceBarrier(const Sequence& cursor,
                   const std::vector<Sequence*>& dependents)
-      : cursor_(cursor), dependents_(dependents), alerted_(false) {}
+      : owned_wait_strategy_(new W()),
+        wait_strategy_(*owned_wait_strategy_),
+        cursor_(cursor),
+        dependents_(dependents),
+        available_sequence_(kInitialCursorValue),
+        alerted_(false) {}
+
+  // Construct a barrier waiting with the sequencer's wait strategy, required
+  // by strategies unblocked through SignalAllWhenBlocking().
+  SequenceBarrier(const Sequence& cursor,
+                  const std::vector<Sequence*>& dependents, W& wait_strategy)
+      : wait_strategy_(wait_strategy),
+        cursor_(cursor),
+        dependents_(dependents),
+        available_sequence_(kInitialCursorValue),
+        alerted_(false) {}
 
   int64_t WaitFor(const int64_t& sequence) {
-    return wait_strategy_.WaitFor(sequence, cursor_, dependents_, alerted_);
+    if (sequence <= available_sequence_ && !alerted())
+      return available_sequence_;
+    return Cache(
+        wait_strategy_.WaitFor(sequence, cursor_, dependents_, alerted_));
   }
 
   template <class R, class P>
   int64_t WaitFor(const int64_t& sequence,
                   const std::chrono::duration<R, P>& timeout) {
-    return wait_strategy_.WaitFor(sequence, cursor_, dependents_, alerted_,
-                                  timeout);
+    if (sequence <= available_sequence_ && !alerted())
+      return available_sequence_;
+    return Cache(wait_strategy_.WaitFor(sequence, cursor_, dependents_,
+                                        alerted_, timeout));
   }
 
   int64_t get_sequence() const { return cursor_.sequence(); }
 
   bool alerted() const {
-    return alerted_.load(std::memory_order::memory_order_acquire);
+    return alerted_.load(std::memory_order_acquire);
   }
 
+  // Alerting the barrier wakes up a consumer blocked in its wait strategy.
   void set_alerted(bool alert) {
-    alerted_.store(alert, std::memory_order::memory_order_release);
+    alerted_.store(alert, std::memory_order_release);
+    if (alert) wait_strategy_.SignalAllWhenBlocking();
+  }
+
+  // Forget the known available sequence and the alert, after the sequencer
+  // was Reset().
+  void Reset() {
+    available_sequence_ = kInitialCursorValue;
+    set_alerted(false);
   }
 
  private:
-  W wait_strategy_;
+  // signals are negative and never cached.
+  inline int64_t Cache(const int64_t& available_sequence) {
+    if (available_sequence > available_sequence_)
+      available_sequence_ = available_sequence;
+    return available_sequence;
+  }
+
+  // only built when the barrier does not share the sequencer's strategy.
+  std::unique_ptr<W> owned_wait_strategy_;
+  W& wait_strategy_;
   const Sequence& cursor_;
   std::vector<Sequence*> dependents_;
+  int64_t available_sequence_;
   std::atomic<bool> alerted_;
 };
 
@@ -38,8 +38,27 @@ template <typename T, size_t N = kDefaultRingBufferSize,
           typename C = kDefaultClaimStrategy, typename W = kDefaultWaitStrategy>
 class Sequencer {
  public:
+  static constexpr size_t kRingSize = N;
+
+  using event_type = typename std::remove_reference<
+      typename RingBuffer<T, N>::reference>::type;
+
   // Construct a Sequencer with the selected strategies.
-  Sequencer(std::array<T, N> events) : ring_buffer_(events) {}
+  Sequencer(const std::array<T, N>& events)
+      : ring_buffer_(events), prefetch_distance_(kNoPrefetch) {}
+
+  // Construct a Sequencer building every event of its ring in place, e.g.
+  // events neither default constructible nor copyable.
+  //
+  // @param factory called as `factory(i)` for the event at index i.
+  template <typename F, typename = EnableIfEventFactory<T, N, F>>
+  explicit Sequencer(F&& factory)
+      : ring_buffer_(std::forward<F>(factory)),
+        prefetch_distance_(kNoPrefetch) {}
+
+  // Construct a Sequencer whose ring default-constructs its own storage, e.g.
+  // a column-wise RingBuffer<Columns<...>, N>.
+  Sequencer() : prefetch_distance_(kNoPrefetch) {}
 
   // Set the sequences that will gate publishers to prevent the buffer
   // wrapping.
@@ -54,8 +73,10 @@ class Sequencer {
   //
   // @param sequences_to_track this barrier will track.
   // @return the barrier gated as required.
-  SequenceBarrier<W> NewBarrier(const std::vector<Sequence*>& dependents) {
-    return SequenceBarrier<W>(cursor_, dependents);
+  std::unique_ptr<SequenceBarrier<W>> NewBarrier(
+      const std::vector<Sequence*>& dependents) {
+    return std::unique_ptr<SequenceBarrier<W>>(
+        new SequenceBarrier<W>(cursor_, dependents, wait_strategy_));
   }
 
   // Get the value of the cursor indicating the published sequence.
@@ -63,6 +84,23 @@ class Sequencer {
   // @return value of the cursor for events that have been published.
   int64_t GetCursor() { return cursor_.sequence(); }
 
+  // Get the cursor itself, for consumers building their own barrier.
+  //
+  // @return the {@link Sequence} of the last published event.
+  const Sequence& cursor() const { return cursor_; }
+
+  // Get the consumer sequence a gated publisher is waiting for.
+  //
+  // @return the {@link Sequence} consumers deferring their progress watch.
+  const Sequence& requested_sequence() const {
+    return claim_strategy_.requested_sequence();
+  }
+
+  // Get the wait strategy signaled on every publication.
+  //
+  // @return the strategy to share with barriers and event loops.
+  W& wait_strategy() { return wait_strategy_; }
+
   // Has the buffer capacity left to allocate another sequence. This is a
   // concurrent method so the response should only be taken as an indication
   // of available capacity.
@@ -77,21 +115,139 @@ class Sequencer {
   // @param delta  the requested number of sequences.
   // @return the maximal claimed sequence
   int64_t Claim(size_t delta = 1) {
-    return claim_strategy_.IncrementAndGet(gating_sequences_, delta);
+    return Prefetched(
+        claim_strategy_.IncrementAndGet(gating_sequences_, delta));
+  }
+
+  // Claim the next sequence of a publisher's lease, requires a claim
+  // strategy with leases, e.g. MultiThreadedStrategy<N, L>.
+  //
+  // @param lease  owned by the calling publisher thread.
+  // @return the claimed sequence.
+  int64_t Claim(SequenceLease& lease) {
+    return Prefetched(
+        claim_strategy_.IncrementAndGet(gating_sequences_, lease));
+  }
+
+  // Prefetch the event `distance` sequences ahead of every claimed
+  // sequence, hiding the miss on events larger than a cache line.
+  //
+  // @param distance in sequences, kNoPrefetch to disable.
+  void set_prefetch_distance(int64_t distance) {
+    prefetch_distance_ = distance;
+  }
+
+  // Prefetch the event at a given sequence, for consumers reading ahead.
+  //
+  // @param sequence for the event.
+  void Prefetch(const int64_t& sequence) const {
+    ring_buffer_.Prefetch(sequence);
+  }
+
+  // Publish the rest of a lease, e.g. when its publisher shuts down or goes
+  // idle, so the cursor can move past it. Each unclaimed event is first
+  // handed to the filler, which must mark it as a no-op for the consumers.
+  //
+  // @param lease   owned by the calling publisher thread.
+  // @param filler  called as `filler(event)` for each unclaimed event.
+  template <typename F>
+  void ReleaseLease(SequenceLease& lease, F&& filler) {
+    const int64_t remaining = lease.remaining();
+    if (remaining <= 0) return;
+
+    for (int64_t sequence = lease.next; sequence <= lease.last; sequence++)
+      filler((*this)[sequence]);
+    Publish(lease.last, remaining);
+    lease = SequenceLease();
   }
 
   // Publish an event and make it visible to {@link EventProcessor}s.
   //
   // @param sequence to be published.
   void Publish(const int64_t& sequence, size_t delta = 1) {
-    claim_strategy_.SynchronizePublishing(sequence, cursor_, delta);
-    const int64_t new_cursor = cursor_.IncrementAndGet(delta);
+    claim_strategy_.Publish(sequence, cursor_, delta);
     wait_strategy_.SignalAllWhenBlocking();
   }
 
-  T& operator[](const int64_t& sequence) { return ring_buffer_[sequence]; }
+  // Construct the event at a claimed sequence in place of the previous one,
+  // without copying it.
+  //
+  // @param sequence claimed by the publisher.
+  // @param args     of the constructor of the event.
+  template <typename... Args>
+  void Emplace(const int64_t& sequence, Args&&... args) {
+    EmplaceEvent((*this)[sequence], std::forward<Args>(args)...);
+  }
+
+  // Claim the next sequence, construct its event in place and publish it,
+  // e.g. `EmplaceAndPublish(std::move(event))` to publish by move.
+  //
+  // @param args of the constructor of the event.
+  // @return the published sequence.
+  template <typename... Args>
+  int64_t EmplaceAndPublish(Args&&... args) {
+    const int64_t sequence = Claim();
+    Emplace(sequence, std::forward<Args>(args)...);
+    Publish(sequence);
+    return sequence;
+  }
+
+  // Move the event at a published sequence out of the ring, leaving it in
+  // its moved-from state. Only the last consumer of the event may take it.
+  //
+  // @param sequence processed by the consumer.
+  // @return the event.
+  event_type Take(const int64_t& sequence) {
+    return std::move((*this)[sequence]);
+  }
+
+  // Run synthetic claim and publish cycles through the running consumers,
+  // warming their caches, pages and branch predictors before going live,
+  // and wait for the gating consumers to process them.
+  //
+  // Once the consumers are halted, Reset() the sequencer and every consumer
+  // to start again from a clean state, see Pipeline::WarmUp().
+  //
+  // @param cycles  number of synthetic events to publish.
+  // @param filler  called as `filler(event)` for each synthetic event, which
+  //                it must mark as such for the handlers.
+  template <typename F>
+  void WarmUp(int64_t cycles, F&& filler) {
+    for (int64_t i = 0; i < cycles; i++) {
+      const int64_t sequence = Claim();
+      filler((*this)[sequence]);
+      Publish(sequence);
+    }
+
+    const int64_t cursor = cursor_.sequence();
+    while (gating_sequences_.size() &&
+           GetMinimumSequence(gating_sequences_) < cursor)
+      std::this_thread::yield();
+  }
+
+  // Move the cursor, the claim strategy and the gating sequences back to
+  // their initial state. No publisher nor consumer may be running.
+  void Reset() {
+    cursor_.set_sequence(kInitialCursorValue);
+    claim_strategy_.Reset();
+    for (Sequence* sequence : gating_sequences_)
+      sequence->set_sequence(kInitialCursorValue);
+  }
+
+  // Get the storage of the events.
+  const RingBuffer<T, N>& ring_buffer() const { return ring_buffer_; }
+
+  typename RingBuffer<T, N>::reference operator[](const int64_t& sequence) {
+    return ring_buffer_[sequence];
+  }
 
  private:
+  inline int64_t Prefetched(const int64_t& sequence) {
+    if (prefetch_distance_ != kNoPrefetch)
+      ring_buffer_.PrefetchForWrite(sequence + prefetch_distance_);
+    return sequence;
+  }
+
   // Members
   RingBuffer<T, N> ring_buffer_;
 
@@ -103,9 +259,14 @@ class Sequencer {
 
   std::vector<Sequence*> gating_sequences_;
 
+  int64_t prefetch_distance_;
+
   DISALLOW_COPY_MOVE_AND_ASSIGN(Sequencer);
 };
 
+template <typename T, size_t N, typename C, typename W>
+constexpr size_t Sequencer<T, N, C, W>::kRingSize;
+
 };  // namespace disruptor
 
 #endif  // DISRUPTOR_RING_BUFFER_H_ NOLINT
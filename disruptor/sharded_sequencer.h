@@ -0,0 +1,221 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_SHARDED_SEQUENCER_H_  // NOLINT
+#define DISRUPTOR_SHARDED_SEQUENCER_H_  // NOLINT
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "disruptor/claim_strategy.h"
+#include "disruptor/fan_in.h"
+#include "disruptor/sequencer.h"
+
+namespace disruptor {
+
+// Alternative to a MultiThreadedStrategy sequencer where every producer
+// thread owns a lane, a single-producer ring using the
+// SingleThreadedStrategy, so producers never contend on a shared claim
+// counter. A single consumer sees the merged stream of all lanes, either in
+// arrival order through a FanInConsumer or ordered by a timestamp.
+//
+// @param <T> event type
+// @param <N> size of each lane's ring
+// @param <W> wait strategy of the lanes and of the merging consumer
+template <typename T, size_t N = kDefaultRingBufferSize,
+          typename W = kDefaultWaitStrategy>
+class ShardedSequencer {
+ public:
+  using Lane = Sequencer<T, N, SingleThreadedStrategy<N>, W>;
+
+  // Construct a sequencer with one lane per producer.
+  //
+  // @param producers   number of producer threads, hence lanes.
+  // @param batch_size  maximum events merged per lane in a round.
+  ShardedSequencer(size_t producers,
+                   int64_t batch_size = kDefaultFanInBatchSize)
+      : ShardedSequencer(producers, [](size_t) { return T(); },
+                         batch_size) {}
+
+  // Construct a sequencer with one lane per producer, building the events of
+  // every lane in place.
+  //
+  // @param producers   number of producer threads, hence lanes.
+  // @param factory     called as `factory(i)` for the event at index i of
+  //                    each lane, see RingBuffer.
+  // @param batch_size  maximum events merged per lane in a round.
+  template <typename F, typename = typename std::enable_if<!std::is_integral<
+                            typename std::decay<F>::type>::value>::type>
+  ShardedSequencer(size_t producers, F&& factory,
+                   int64_t batch_size = kDefaultFanInBatchSize)
+      : lanes_(BuildLanes(producers, factory)),
+        fan_in_(LanePointers(lanes_), batch_size),
+        batch_size_(batch_size),
+        next_sequences_(producers),
+        available_sequences_(producers),
+        last_timestamps_(producers, kNoTimestamp) {
+    for (size_t i = 0; i < lanes_.size(); i++)
+      lanes_[i]->set_gating_sequences({&fan_in_.sequence(i)});
+  }
+
+  // Get the lane reserved to a producer, on which it claims and publishes
+  // like on any single producer Sequencer.
+  //
+  // @param producer  index of the producer.
+  Lane& lane(size_t producer) { return *lanes_[producer]; }
+
+  // Get the number of lanes.
+  size_t size() const { return lanes_.size(); }
+
+  // Get the merging consumer's progress on a lane.
+  Sequence& sequence(size_t lane) { return fan_in_.sequence(lane); }
+
+  // Merge the available events of every lane in arrival order.
+  //
+  // @param handler  called as `handler(lane, event, sequence, end_of_batch)`.
+  // @return the number of handled events.
+  template <typename H>
+  int64_t Drain(H&& handler) {
+    return fan_in_.Drain(handler);
+  }
+
+  // Merge the available events of every lane by increasing timestamp.
+  //
+  // Lanes must publish with non-decreasing timestamps. A lane without
+  // available events may still publish one as old as its last event, so
+  // that last timestamp is a watermark: events past the watermark of any
+  // lane are held back until it publishes again, and the merged stream is
+  // ordered across calls. A lane that never published, or stopped
+  // publishing, thus holds back the newer events of the other lanes.
+  //
+  // @param handler    called as `handler(lane, event, sequence)`.
+  // @param timestamp  called as `timestamp(event)`, returns the int64_t
+  //                   sort key.
+  // @return the number of handled events.
+  template <typename H, typename K>
+  int64_t DrainOrdered(H&& handler, K&& timestamp) {
+    const size_t lanes = lanes_.size();
+    std::vector<int64_t>& next_sequences = next_sequences_;
+    std::vector<int64_t>& available_sequences = available_sequences_;
+    for (size_t i = 0; i < lanes; i++) {
+      next_sequences[i] = fan_in_.progress(i).processed() + 1L;
+      available_sequences[i] = std::min(lanes_[i]->GetCursor(),
+                                         next_sequences[i] + batch_size_ - 1);
+    }
+
+    int64_t processed = 0;
+    while (true) {
+      size_t lane = lanes;
+      int64_t earliest = 0;
+      int64_t watermark = std::numeric_limits<int64_t>::max();
+      for (size_t i = 0; i < lanes; i++) {
+        if (next_sequences[i] > available_sequences[i]) {
+          watermark = std::min(watermark, last_timestamps_[i]);
+          continue;
+        }
+        const int64_t head = timestamp((*lanes_[i])[next_sequences[i]]);
+        if (lane == lanes || head < earliest) {
+          lane = i;
+          earliest = head;
+        }
+      }
+      if (lane == lanes || earliest > watermark) break;
+
+      const int64_t sequence = next_sequences[lane]++;
+      handler(lane, (*lanes_[lane])[sequence], sequence);
+      fan_in_.progress(lane).Processed(sequence);
+      last_timestamps_[lane] = earliest;
+      processed++;
+    }
+
+    for (size_t i = 0; i < lanes; i++) fan_in_.progress(i).Publish();
+
+    return processed;
+  }
+
+  // Merge in arrival order until alerted.
+  template <typename H>
+  void Run(H&& handler) {
+    fan_in_.Run(handler);
+  }
+
+  // Merge by timestamp until alerted.
+  template <typename H, typename K>
+  void RunOrdered(H&& handler, K&& timestamp) {
+    int64_t idle_rounds = 0;
+    while (!alerted()) {
+      if (DrainOrdered(handler, timestamp))
+        idle_rounds = 0;
+      else
+        wait_strategy_.Idle(idle_rounds++);
+    }
+  }
+
+  bool alerted() const { return fan_in_.alerted(); }
+
+  void set_alerted(bool alert) { fan_in_.set_alerted(alert); }
+
+ private:
+  // watermark of a lane which never published.
+  static constexpr int64_t kNoTimestamp = std::numeric_limits<int64_t>::min();
+
+  template <typename F>
+  static std::vector<std::unique_ptr<Lane>> BuildLanes(size_t producers,
+                                                       F& factory) {
+    std::vector<std::unique_ptr<Lane>> lanes;
+    for (size_t i = 0; i < producers; i++)
+      lanes.emplace_back(new Lane(factory));
+    return lanes;
+  }
+
+  static std::vector<Lane*> LanePointers(
+      const std::vector<std::unique_ptr<Lane>>& lanes) {
+    std::vector<Lane*> pointers;
+    for (const auto& lane : lanes) pointers.push_back(lane.get());
+    return pointers;
+  }
+
+  std::vector<std::unique_ptr<Lane>> lanes_;
+  FanInConsumer<Lane, W> fan_in_;
+  const int64_t batch_size_;
+  // merge positions, preallocated to keep DrainOrdered() allocation free.
+  std::vector<int64_t> next_sequences_;
+  std::vector<int64_t> available_sequences_;
+  // timestamp of the last merged event of every lane.
+  std::vector<int64_t> last_timestamps_;
+  W wait_strategy_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(ShardedSequencer);
+};
+
+template <typename T, size_t N, typename W>
+constexpr int64_t ShardedSequencer<T, N, W>::kNoTimestamp;
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_SHARDED_SEQUENCER_H_ NOLINT
@@ -0,0 +1,259 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_SHARED_MEMORY_H_  // NOLINT
+#define DISRUPTOR_SHARED_MEMORY_H_  // NOLINT
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <new>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "disruptor/claim_strategy.h"
+#include "disruptor/sequence.h"
+#include "disruptor/utils.h"
+
+namespace disruptor {
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+              "Sequence must be lock-free to be shared across processes");
+
+constexpr uint64_t kSharedRingMagic = 0x474e495244525344UL;  // "DSRDRING"
+constexpr uint64_t kSharedRingVersion = 3UL;
+
+// How a SharedSequencer attaches to its shared memory segment.
+enum class SharedMemoryMode {
+  // Create and initialize the segment, fails if it already exists.
+  kCreate,
+  // Attach to a segment initialized by another process.
+  kOpen
+};
+
+// Fixed binary layout of a ring placed in shared memory. Every process
+// mapping the segment must be built with the same T, N, C and K.
+//
+// The header is followed by the cursor, the K consumers' sequences, the
+// state of the claim strategy and finally the events. Every Sequence is
+// padded with kCacheLinePadding, which every process must agree on, none of
+// the members hold pointers.
+template <typename T, size_t N, typename C, size_t K>
+struct SharedRingLayout {
+  uint64_t magic;
+  uint64_t version;
+  uint64_t size;
+  uint64_t event_size;
+  uint64_t ring_size;
+  uint64_t consumers;
+  std::atomic<uint64_t> ready;
+  // padding
+  int64_t padding_[(CACHE_LINE_SIZE_IN_BYTES - 7 * sizeof(uint64_t)) / 8];
+
+  Sequence cursor;
+  Sequence consumer_sequences[K];
+  C claim_strategy;
+  T events[N];
+};
+
+// Sequencer whose ring, cursor, claim state and consumers' {@link Sequence}s
+// live in a named POSIX shared memory segment, so publishers and consumers
+// can run in different processes with the same lock-free protocol.
+//
+// Consumers build a SequenceBarrier on `cursor()` and publish their
+// progress in `consumer_sequence(i)`, which gates the publishers. Since the
+// strategies' signals do not cross processes, consumers should use one of
+// the spinning wait strategies.
+//
+// @param <T> event type, must be trivially copyable.
+// @param <N> size of the ring.
+// @param <C> claim strategy, MultiThreadedStrategy for publishers in many
+//            processes.
+// @param <K> number of consumers gating the publishers.
+template <typename T, size_t N = kDefaultRingBufferSize,
+          typename C = SingleThreadedStrategy<N>, size_t K = 1>
+class SharedSequencer {
+ public:
+  static constexpr size_t kRingSize = N;
+
+  using Layout = SharedRingLayout<T, N, C, K>;
+
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SharedSequencer requires a trivially copyable event type");
+  static_assert(((N > 0) && ((N & (~N + 1)) == N)),
+                "RingBuffer's size must be a positive power of 2");
+  static_assert(K > 0, "SharedSequencer requires at least one consumer");
+
+  // Map the named segment.
+  //
+  // @param name  of the segment, as given to shm_open(), e.g. "/feed".
+  // @param mode  create the segment or attach to an existing one.
+  SharedSequencer(const std::string& name, SharedMemoryMode mode)
+      : name_(name), layout_(nullptr) {
+    const bool create = (mode == SharedMemoryMode::kCreate);
+    const int flags = create ? O_RDWR | O_CREAT | O_EXCL : O_RDWR;
+    const int fd = ::shm_open(name.c_str(), flags, 0600);
+    if (fd < 0) throw std::system_error(errno, std::system_category(), name);
+
+    if (create && ::ftruncate(fd, sizeof(Layout)) < 0) Fail(fd, create);
+
+    struct stat st;
+    // the creator may not have sized the segment yet.
+    do {
+      if (::fstat(fd, &st) < 0) Fail(fd, create);
+      if (!st.st_size) std::this_thread::yield();
+    } while (!st.st_size);
+    if (static_cast<size_t>(st.st_size) != sizeof(Layout))
+      Fail(fd, create, EINVAL);
+
+    void* data = ::mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE,
+                        MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) Fail(fd, create);
+    ::close(fd);
+    layout_ = static_cast<Layout*>(data);
+
+    if (create) {
+      Initialize();
+    } else {
+      while (!layout_->ready.load(std::memory_order_acquire))
+        std::this_thread::yield();
+      if (!Validate()) {
+        ::munmap(layout_, sizeof(Layout));
+        throw std::system_error(EINVAL, std::system_category(), name);
+      }
+    }
+
+    for (size_t i = 0; i < K; i++)
+      gating_sequences_.push_back(&layout_->consumer_sequences[i]);
+  }
+
+  ~SharedSequencer() { ::munmap(layout_, sizeof(Layout)); }
+
+  // Remove the segment's name, mappings stay valid until unmapped.
+  //
+  // @param name  of the segment.
+  static void Unlink(const std::string& name) { ::shm_unlink(name.c_str()); }
+
+  // Get the value of the cursor indicating the published sequence.
+  int64_t GetCursor() const { return layout_->cursor.sequence(); }
+
+  // Get the shared cursor, for consumers building their barrier.
+  const Sequence& cursor() const { return layout_->cursor; }
+
+  // Get the consumer sequence a gated publisher is waiting for.
+  const Sequence& requested_sequence() const {
+    return layout_->claim_strategy.requested_sequence();
+  }
+
+  // Prefetch the event at a given sequence, for consumers reading ahead.
+  void Prefetch(const int64_t& sequence) const {
+    PrefetchObject<false>(&layout_->events[sequence & (N - 1)]);
+  }
+
+  // Get the shared {@link Sequence} of the i-th consumer.
+  Sequence& consumer_sequence(size_t i) {
+    return layout_->consumer_sequences[i];
+  }
+
+  // Has the buffer capacity left to allocate another sequence.
+  bool HasAvailableCapacity() {
+    return layout_->claim_strategy.HasAvailableCapacity(gating_sequences_);
+  }
+
+  // Claim the next batch of sequence numbers for publishing.
+  //
+  // @param delta  the requested number of sequences.
+  // @return the maximal claimed sequence
+  int64_t Claim(size_t delta = 1) {
+    return layout_->claim_strategy.IncrementAndGet(gating_sequences_, delta);
+  }
+
+  // Publish an event and make it visible to every process.
+  //
+  // @param sequence to be published.
+  void Publish(const int64_t& sequence, size_t delta = 1) {
+    layout_->claim_strategy.Publish(sequence, layout_->cursor, delta);
+  }
+
+  T& operator[](const int64_t& sequence) {
+    return layout_->events[sequence & (N - 1)];
+  }
+
+  const T& operator[](const int64_t& sequence) const {
+    return layout_->events[sequence & (N - 1)];
+  }
+
+ private:
+  void Initialize() {
+    // ftruncate() zero-filled the segment, construct the sequences and
+    // claim strategy in place then publish the header.
+    new (&layout_->cursor) Sequence();
+    for (size_t i = 0; i < K; i++)
+      new (&layout_->consumer_sequences[i]) Sequence();
+    new (&layout_->claim_strategy) C();
+
+    layout_->magic = kSharedRingMagic;
+    layout_->version = kSharedRingVersion;
+    layout_->size = sizeof(Layout);
+    layout_->event_size = sizeof(T);
+    layout_->ring_size = N;
+    layout_->consumers = K;
+    layout_->ready.store(1, std::memory_order_release);
+  }
+
+  bool Validate() const {
+    return layout_->magic == kSharedRingMagic &&
+           layout_->version == kSharedRingVersion &&
+           layout_->size == sizeof(Layout) &&
+           layout_->event_size == sizeof(T) && layout_->ring_size == N &&
+           layout_->consumers == K;
+  }
+
+  void Fail(int fd, bool created, int err = errno) {
+    ::close(fd);
+    if (created) Unlink(name_);
+    throw std::system_error(err, std::system_category(), name_);
+  }
+
+  const std::string name_;
+  Layout* layout_;
+  std::vector<Sequence*> gating_sequences_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(SharedSequencer);
+};
+
+template <typename T, size_t N, typename C, size_t K>
+constexpr size_t SharedSequencer<T, N, C, K>::kRingSize;
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_SHARED_MEMORY_H_ NOLINT
@@ -0,0 +1,277 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_THREAD_RUNNER_H_  // NOLINT
+#define DISRUPTOR_THREAD_RUNNER_H_  // NOLINT
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "disruptor/utils.h"
+
+namespace disruptor {
+
+constexpr int kAnyCpu = -1;
+constexpr int kDefaultPriority = 0;
+
+// Linux truncates thread names to 15 characters.
+constexpr size_t kMaxThreadNameLength = 15;
+
+// Placement and scheduling of a thread launched by a ThreadRunner.
+struct ThreadOptions {
+  // @param name       of the thread, as shown by top and perf.
+  // @param cpu        to pin the thread on, kAnyCpu leaves it unpinned.
+  // @param priority   SCHED_FIFO priority, kDefaultPriority keeps the
+  //                   default time-sharing policy.
+  // @param busy_spin  the thread spins and must own its physical core, on
+  //                   a cpu isolated from the scheduler.
+  ThreadOptions(const std::string& name, int cpu = kAnyCpu,
+                int priority = kDefaultPriority, bool busy_spin = false)
+      : name(name), cpu(cpu), priority(priority), busy_spin(busy_spin) {}
+
+  std::string name;
+  int cpu;
+  int priority;
+  bool busy_spin;
+};
+
+// Physical core of a logical cpu, as exposed by the kernel topology.
+struct PhysicalCore {
+  int package_id;
+  int core_id;
+
+  bool operator==(const PhysicalCore& other) const {
+    return package_id == other.package_id && core_id == other.core_id;
+  }
+};
+
+// used internally, read an integer from a sysfs file.
+static inline int ReadTopologyValue(int cpu, const char* attribute) {
+  char path[128];
+  std::snprintf(path, sizeof(path),
+                "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, attribute);
+
+  FILE* file = std::fopen(path, "r");
+  if (file == nullptr)
+    throw std::system_error(errno, std::system_category(), path);
+
+  int value = 0;
+  const int matched = std::fscanf(file, "%d", &value);
+  std::fclose(file);
+  if (matched != 1)
+    throw std::system_error(EINVAL, std::system_category(), path);
+
+  return value;
+}
+
+// Get the physical core of a logical cpu, hyper-threads of the same core
+// share it.
+//
+// @param cpu logical cpu number.
+// @return physical core of the cpu.
+static inline PhysicalCore GetPhysicalCore(int cpu) {
+  return PhysicalCore{ReadTopologyValue(cpu, "physical_package_id"),
+                      ReadTopologyValue(cpu, "core_id")};
+}
+
+// used internally, is a cpu part of a kernel cpu list, e.g. "0-3,8,10-11".
+static inline bool CpuListContains(const char* list, int cpu) {
+  while (*list) {
+    char* end;
+    const int64_t first = std::strtol(list, &end, 10);
+    if (end == list) return false;
+
+    int64_t last = first;
+    if (*end == '-') {
+      list = end + 1;
+      last = std::strtol(list, &end, 10);
+      if (end == list) return false;
+    }
+    if (first <= cpu && cpu <= last) return true;
+
+    if (*end != ',') return false;
+    list = end + 1;
+  }
+  return false;
+}
+
+// Get the logical cpus removed from the scheduler's balancing, e.g. with the
+// isolcpus boot parameter, so no other task runs on them.
+//
+// @return the kernel cpu list, empty when the kernel does not report
+//         isolated cpus.
+static inline std::string ReadIsolatedCpus() {
+  FILE* file = std::fopen("/sys/devices/system/cpu/isolated", "r");
+  if (file == nullptr) return std::string();
+
+  char list[4096] = {0};
+  const bool read = std::fgets(list, sizeof(list), file) != nullptr;
+  std::fclose(file);
+  return read ? std::string(list) : std::string();
+}
+
+// A busy-spinning thread launched by a ThreadRunner.
+struct Spinner {
+  std::string name;
+  PhysicalCore core;
+};
+
+// Check a busy-spinning thread owns its physical core: it must be pinned on
+// an isolated cpu, whose core no other spinning thread runs on.
+//
+// @param options        of the busy-spin thread.
+// @param core           physical core of options.cpu.
+// @param isolated_cpus  kernel cpu list of the isolated cpus.
+// @param spinning       threads already spinning.
+// @throw std::invalid_argument if the thread cannot own its core.
+static inline void CheckBusySpinPlacement(
+    const ThreadOptions& options, const PhysicalCore& core,
+    const std::string& isolated_cpus, const std::vector<Spinner>& spinning) {
+  if (options.cpu == kAnyCpu)
+    throw std::invalid_argument("busy-spin thread " + options.name +
+                                " is not pinned");
+
+  if (!CpuListContains(isolated_cpus.c_str(), options.cpu))
+    throw std::invalid_argument("busy-spin thread " + options.name +
+                                " on cpu " + std::to_string(options.cpu) +
+                                " which is not isolated");
+
+  for (const Spinner& spinner : spinning)
+    if (spinner.core == core)
+      throw std::invalid_argument("busy-spin threads " + spinner.name +
+                                  " and " + options.name +
+                                  " share a physical core");
+}
+
+// Launches threads onto their configured cpus, with an optional realtime
+// priority and a name.
+//
+// Busy-spinning threads sharing a physical core, either on the same cpu or
+// on hyper-thread siblings, compete for the same execution units and
+// destroy each other's latency: the runner refuses to launch them, as well
+// as busy-spinning threads on a cpu the scheduler still uses. Every
+// setting is applied by the thread itself before it runs its function, a
+// failure is rethrown by Launch() and the function is never called.
+class ThreadRunner {
+ public:
+  ThreadRunner() {}
+
+  ~ThreadRunner() { Join(); }
+
+  // Launch a thread.
+  //
+  // @param options  placement and scheduling of the thread.
+  // @param function to run on the thread.
+  // @throw std::invalid_argument if the name is too long or if a busy-spin
+  //        thread cannot own its physical core, see CheckBusySpinPlacement.
+  // @throw std::system_error if the thread cannot be configured.
+  void Launch(const ThreadOptions& options, std::function<void()> function) {
+    if (options.name.size() > kMaxThreadNameLength)
+      throw std::invalid_argument("thread name too long: " + options.name);
+
+    PhysicalCore core = {-1, -1};
+    if (options.cpu != kAnyCpu) core = GetPhysicalCore(options.cpu);
+    if (options.busy_spin)
+      CheckBusySpinPlacement(options, core, ReadIsolatedCpus(), spinning_);
+
+    std::promise<void> configured;
+    std::future<void> result = configured.get_future();
+    std::thread thread([options, function, &configured]() {
+      try {
+        Configure(options);
+      } catch (...) {
+        configured.set_exception(std::current_exception());
+        return;
+      }
+      configured.set_value();
+      function();
+    });
+
+    try {
+      result.get();
+    } catch (...) {
+      thread.join();
+      throw;
+    }
+
+    threads_.push_back(std::move(thread));
+    if (options.busy_spin)
+      spinning_.push_back(Spinner{options.name, core});
+  }
+
+  // Wait for every launched thread to return.
+  void Join() {
+    for (auto& thread : threads_) thread.join();
+    threads_.clear();
+    spinning_.clear();
+  }
+
+  size_t size() const { return threads_.size(); }
+
+ private:
+  static void Configure(const ThreadOptions& options) {
+    const pthread_t self = pthread_self();
+
+    int err = pthread_setname_np(self, options.name.c_str());
+    if (err != 0) throw std::system_error(err, std::system_category(), "name");
+
+    if (options.cpu != kAnyCpu) {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(options.cpu, &cpus);
+      err = pthread_setaffinity_np(self, sizeof(cpus), &cpus);
+      if (err != 0)
+        throw std::system_error(err, std::system_category(), "affinity");
+    }
+
+    if (options.priority != kDefaultPriority) {
+      sched_param param;
+      param.sched_priority = options.priority;
+      err = pthread_setschedparam(self, SCHED_FIFO, &param);
+      if (err != 0)
+        throw std::system_error(err, std::system_category(), "priority");
+    }
+  }
+
+  std::vector<std::thread> threads_;
+  std::vector<Spinner> spinning_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(ThreadRunner);
+};
+
+};  // namespace disruptor
+
+#endif  // DISRUPTOR_THREAD_RUNNER_H_ NOLINT
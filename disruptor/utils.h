@@ -23,9 +23,17 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
 // THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#ifndef CACHE_LINE_SIZE_IN_BYTES     // NOLINT
+#define CACHE_LINE_SIZE_IN_BYTES 64  // NOLINT
+#endif                               // NOLINT
+
 #ifndef DISRUPTOR_UTILS_H_  // NOLINT
 #define DISRUPTOR_UTILS_H_  // NOLINT
 
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
 // From Google C++ Standard, modified to use C++11 deleted functions.
 // A macro to disallow the copy constructor and operator= functions.
 #define DISALLOW_COPY_MOVE_AND_ASSIGN(TypeName) \
@@ -33,4 +41,40 @@
   TypeName(const TypeName&&) = delete;          \
   void operator=(const TypeName&) = delete
 
+namespace disruptor {
+
+// Distance in bytes keeping two objects written by different threads from
+// sharing a cache line, CACHE_LINE_SIZE_IN_BYTES.
+//
+// It sizes the padding of {@link Sequence} and thus the layout of every
+// structure holding one, e.g. a ring shared between processes. Defining
+// DISRUPTOR_USE_HARDWARE_INTERFERENCE_SIZE opts in to the C++17
+// std::hardware_destructive_interference_size instead, whose value varies
+// with the compiler and its -mtune flags: every build sharing these types
+// must then agree on it.
+#if defined(DISRUPTOR_USE_HARDWARE_INTERFERENCE_SIZE) && \
+    defined(__cpp_lib_hardware_interference_size)
+constexpr size_t kCacheLinePadding =
+    std::hardware_destructive_interference_size;
+#else
+constexpr size_t kCacheLinePadding = CACHE_LINE_SIZE_IN_BYTES;
+#endif
+
+// Hint the processor to pull every cache line of an object in its cache,
+// for writing when Write is true. Compiled out without __builtin_prefetch.
+//
+// @param object to prefetch.
+template <bool Write, typename T>
+inline void PrefetchObject(const T* object) {
+#if defined(__GNUC__)
+  const uintptr_t first = reinterpret_cast<uintptr_t>(object) &
+                          ~(uintptr_t(CACHE_LINE_SIZE_IN_BYTES) - 1);
+  const uintptr_t last = reinterpret_cast<uintptr_t>(object) + sizeof(T) - 1;
+  for (uintptr_t line = first; line <= last; line += CACHE_LINE_SIZE_IN_BYTES)
+    __builtin_prefetch(reinterpret_cast<const void*>(line), Write ? 1 : 0, 3);
+#endif
+}
+
+};  // namespace disruptor
+
 #endif  // DISRUPTOR_UTILS_H_ NOLINT
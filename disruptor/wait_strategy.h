@@ -31,6 +31,8 @@
 #include <chrono>
 #include <thread>
 #include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <vector>
 
 #include "disruptor/sequence.h"
@@ -81,6 +83,12 @@ class WaitStrategy {
   // Signal the strategy that the cursor as advanced. Some strategy depends
   // on this behaviour to unblock.
   void SignalAllWhenBlocking();
+
+  // Back off once when a consumer polling several rings found all of them
+  // empty. Only provided by the spinning strategies.
+  //
+  // @param idle_rounds consecutive empty rounds so far, starting at 0.
+  void Idle(const int64_t& idle_rounds);
 };
 */
 
@@ -120,11 +128,26 @@ class SleepingStrategy;
 // low-latency are not as important as CPU resource.
 class BlockingStrategy;
 
+// Adaptive strategy that learns how long the consumer usually waits and
+// picks its back off phase accordingly: spinning while events arrive less
+// than SpinNanos apart, yielding while they arrive less than YieldNanos
+// apart, and otherwise parking with sleeps of duration<D,DV>. Whatever the
+// phase it started in, a long wait escalates to the next phases once it
+// outlasts the recent waits: the thresholds follow the average wait plus
+// twice its average deviation, bounded by SpinNanos and YieldNanos. This
+// keeps spin-level latency through bursts without burning a core during
+// quiet periods.
+template <int64_t SpinNanos, int64_t YieldNanos, typename D, int DV>
+class AdaptiveStrategy;
+
 // defaults
 using kDefaultWaitStrategy = BusySpinStrategy;
 constexpr int64_t kDefaultRetryLoops = 200L;
 using kDefaultDuration = std::chrono::milliseconds;
 constexpr int kDefaultDurationValue = 1;
+constexpr int64_t kDefaultAdaptiveSpinNanos = 10000L;
+constexpr int64_t kDefaultAdaptiveYieldNanos = 1000000L;
+constexpr int64_t kMinAdaptiveSpinNanos = 1000L;
 
 // used internally
 static inline std::function<int64_t()> buildMinSequenceFunction(
@@ -141,7 +164,7 @@ class BusySpinStrategy {
     const auto min_sequence = buildMinSequenceFunction(cursor, dependents);
 
     while ((available_sequence = min_sequence()) < sequence) {
-      if (alerted.load()) return kAlertedSignal;
+      if (alerted.load(std::memory_order_acquire)) return kAlertedSignal;
     }
 
     return available_sequence;
@@ -159,7 +182,7 @@ class BusySpinStrategy {
     const auto min_sequence = buildMinSequenceFunction(cursor, dependents);
 
     while ((available_sequence = min_sequence()) < sequence) {
-      if (alerted.load()) return kAlertedSignal;
+      if (alerted.load(std::memory_order_acquire)) return kAlertedSignal;
 
       if (stop <= std::chrono::system_clock::now()) return kTimeoutSignal;
     }
@@ -169,6 +192,8 @@ class BusySpinStrategy {
 
   virtual void SignalAllWhenBlocking() {}
 
+  void Idle(const int64_t& /*idle_rounds*/) {}
+
   DISALLOW_COPY_MOVE_AND_ASSIGN(BusySpinStrategy);
 };
 
@@ -186,7 +211,7 @@ class YieldingStrategy {
     const auto min_sequence = buildMinSequenceFunction(cursor, dependents);
 
     while ((available_sequence = min_sequence()) < sequence) {
-      if (alerted.load()) return kAlertedSignal;
+      if (alerted.load(std::memory_order_acquire)) return kAlertedSignal;
 
       counter = ApplyWaitMethod(counter);
     }
@@ -207,7 +232,7 @@ class YieldingStrategy {
     const auto min_sequence = buildMinSequenceFunction(cursor, dependents);
 
     while ((available_sequence = min_sequence()) < sequence) {
-      if (alerted.load()) return kAlertedSignal;
+      if (alerted.load(std::memory_order_acquire)) return kAlertedSignal;
 
       counter = ApplyWaitMethod(counter);
 
@@ -219,6 +244,10 @@ class YieldingStrategy {
 
   virtual void SignalAllWhenBlocking() {}
 
+  void Idle(const int64_t& idle_rounds) {
+    if (idle_rounds >= S) std::this_thread::yield();
+  }
+
  private:
   inline int64_t ApplyWaitMethod(int64_t counter) {
     if (counter) {
@@ -247,7 +276,7 @@ class SleepingStrategy {
     const auto min_sequence = buildMinSequenceFunction(cursor, dependents);
 
     while ((available_sequence = min_sequence()) < sequence) {
-      if (alerted.load()) return kAlertedSignal;
+      if (alerted.load(std::memory_order_acquire)) return kAlertedSignal;
 
       counter = ApplyWaitMethod(counter);
     }
@@ -268,7 +297,7 @@ class SleepingStrategy {
     const auto min_sequence = buildMinSequenceFunction(cursor, dependents);
 
     while ((available_sequence = min_sequence()) < sequence) {
-      if (alerted.load()) return kAlertedSignal;
+      if (alerted.load(std::memory_order_acquire)) return kAlertedSignal;
 
       counter = ApplyWaitMethod(counter);
 
@@ -280,6 +309,8 @@ class SleepingStrategy {
 
   void SignalAllWhenBlocking() {}
 
+  void Idle(const int64_t& idle_rounds) { ApplyWaitMethod(S - idle_rounds); }
+
  private:
   inline int64_t ApplyWaitMethod(int64_t counter) {
     if (counter > (S / 2)) {
@@ -343,7 +374,7 @@ class BlockingStrategy {
     if ((available_sequence = cursor.sequence()) < sequence) {
       std::unique_lock<std::recursive_mutex> ulock(mutex_);
       while ((available_sequence = cursor.sequence()) < sequence) {
-        if (alerted) return kAlertedSignal;
+        if (alerted.load(std::memory_order_acquire)) return kAlertedSignal;
 
         // locker indicate if a timeout occured
         if (locker(ulock)) return kTimeoutSignal;
@@ -353,7 +384,7 @@ class BlockingStrategy {
     // Now we wait on dependents.
     if (dependents.size()) {
       while ((available_sequence = GetMinimumSequence(dependents)) < sequence) {
-        if (alerted) return kAlertedSignal;
+        if (alerted.load(std::memory_order_acquire)) return kAlertedSignal;
       }
     }
 
@@ -367,6 +398,190 @@ class BlockingStrategy {
   DISALLOW_COPY_MOVE_AND_ASSIGN(BlockingStrategy);
 };
 
+enum class WaitPhase { kSpin, kYield, kPark };
+
+template <int64_t SpinNanos = kDefaultAdaptiveSpinNanos,
+          int64_t YieldNanos = kDefaultAdaptiveYieldNanos,
+          typename D = kDefaultDuration, int DV = kDefaultDurationValue>
+class AdaptiveStrategy {
+ public:
+  static_assert(SpinNanos <= YieldNanos,
+                "spinning must stop before yielding does");
+
+  AdaptiveStrategy()
+      : expected_wait_nanos_(0),
+        wait_deviation_nanos_(0),
+        idle_start_(Clock::now()),
+        idle_phase_(WaitPhase::kSpin),
+        idle_nanos_(0),
+        idle_spinning_(true) {}
+
+  int64_t WaitFor(const int64_t& sequence, const Sequence& cursor,
+                  const std::vector<Sequence*>& dependents,
+                  const std::atomic<bool>& alerted) {
+    return WaitFor(sequence, cursor, dependents, alerted,
+                   std::chrono::nanoseconds::max());
+  }
+
+  template <class R, class P>
+  int64_t WaitFor(const int64_t& sequence, const Sequence& cursor,
+                  const std::vector<Sequence*>& dependents,
+                  const std::atomic<bool>& alerted,
+                  const std::chrono::duration<R, P>& timeout) {
+    const auto min_sequence = buildMinSequenceFunction(cursor, dependents);
+
+    // the consumer is behind, events arrive faster than it consumes them.
+    int64_t available_sequence = min_sequence();
+    if (available_sequence >= sequence) {
+      Record(0);
+      return available_sequence;
+    }
+
+    const WaitPhase start_phase = phase();
+    const auto start = Clock::now();
+    const int64_t timeout_nanos =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+
+    const int64_t spin_nanos = spin_threshold_nanos();
+    const int64_t yield_nanos = yield_threshold_nanos();
+    bool spinning = (start_phase == WaitPhase::kSpin);
+    int64_t rounds = 0;
+    while ((available_sequence = min_sequence()) < sequence) {
+      if (alerted.load(std::memory_order_acquire)) return kAlertedSignal;
+      // reading the clock costs more than a spin round.
+      if (spinning && (++rounds & (kClockSampleRounds - 1))) continue;
+
+      const int64_t waited_nanos = ElapsedNanos(start);
+      if (waited_nanos >= timeout_nanos) return kTimeoutSignal;
+
+      spinning = Backoff(start_phase, waited_nanos, spin_nanos, yield_nanos);
+    }
+
+    Record(ElapsedNanos(start));
+    return available_sequence;
+  }
+
+  void SignalAllWhenBlocking() {}
+
+  // Idle streaks are timed like waits, the duration of the previous streak
+  // is recorded when a new one starts.
+  void Idle(const int64_t& idle_rounds) {
+    if (idle_rounds == 0) {
+      Record(idle_nanos_);
+      idle_start_ = Clock::now();
+      idle_phase_ = phase();
+      idle_spinning_ = (idle_phase_ == WaitPhase::kSpin);
+    }
+    if (idle_spinning_ && (idle_rounds & (kClockSampleRounds - 1))) return;
+
+    idle_nanos_ = ElapsedNanos(idle_start_);
+    idle_spinning_ = Backoff(idle_phase_, idle_nanos_, spin_threshold_nanos(),
+                             yield_threshold_nanos());
+  }
+
+  // Phase a new wait starts in, given the recent waits.
+  WaitPhase phase() const {
+    const int64_t expected = expected_wait_nanos();
+    if (expected < SpinNanos) return WaitPhase::kSpin;
+    if (expected < YieldNanos) return WaitPhase::kYield;
+    return WaitPhase::kPark;
+  }
+
+  // Moving average of the recent waits, in nanoseconds.
+  int64_t expected_wait_nanos() const {
+    return expected_wait_nanos_.load(std::memory_order_relaxed);
+  }
+
+  // Moving average of the distance between a wait and the average, in
+  // nanoseconds.
+  int64_t wait_deviation_nanos() const {
+    return wait_deviation_nanos_.load(std::memory_order_relaxed);
+  }
+
+  // Time a wait spins before yielding, beyond which it outlasts most of the
+  // recent waits.
+  int64_t spin_threshold_nanos() const {
+    return Clamp(WaitBoundNanos(),
+                 SpinNanos < kMinAdaptiveSpinNanos ? SpinNanos
+                                                   : kMinAdaptiveSpinNanos,
+                 SpinNanos);
+  }
+
+  // Time a wait yields before parking.
+  int64_t yield_threshold_nanos() const {
+    return Clamp(WaitBoundNanos(), SpinNanos, YieldNanos);
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  // weight of a new sample in the moving averages, as a power of 2.
+  static constexpr int kSmoothingShift = 3;
+  // spin rounds between two clock reads, a power of 2.
+  static constexpr int64_t kClockSampleRounds = 64;
+
+  static int64_t Clamp(int64_t value, int64_t low, int64_t high) {
+    return value < low ? low : value > high ? high : value;
+  }
+
+  int64_t WaitBoundNanos() const {
+    return expected_wait_nanos() + 2 * wait_deviation_nanos();
+  }
+
+  static int64_t ElapsedNanos(const Clock::time_point& start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                                start)
+        .count();
+  }
+
+  // @return true if the wait keeps spinning.
+  inline bool Backoff(WaitPhase start_phase, int64_t waited_nanos,
+                      int64_t spin_nanos, int64_t yield_nanos) {
+    if (start_phase == WaitPhase::kSpin && waited_nanos < spin_nanos)
+      return true;
+
+    if (start_phase != WaitPhase::kPark && waited_nanos < yield_nanos) {
+      std::this_thread::yield();
+      return false;
+    }
+
+    std::this_thread::sleep_for(D(DV));
+    return false;
+  }
+
+  // Several consumers may share the strategy, losing an update to a race
+  // only slows down the adaptation.
+  inline void Record(int64_t waited_nanos) {
+    const int64_t expected = expected_wait_nanos();
+    const int64_t deviation = wait_deviation_nanos();
+    const int64_t distance = waited_nanos > expected ? waited_nanos - expected
+                                                     : expected - waited_nanos;
+    expected_wait_nanos_.store(
+        expected + ((waited_nanos - expected) >> kSmoothingShift),
+        std::memory_order_relaxed);
+    wait_deviation_nanos_.store(
+        deviation + ((distance - deviation) >> kSmoothingShift),
+        std::memory_order_relaxed);
+  }
+
+  std::atomic<int64_t> expected_wait_nanos_;
+  std::atomic<int64_t> wait_deviation_nanos_;
+
+  // state of the idle streaks, only used by a single polling consumer.
+  Clock::time_point idle_start_;
+  WaitPhase idle_phase_;
+  int64_t idle_nanos_;
+  bool idle_spinning_;
+
+  DISALLOW_COPY_MOVE_AND_ASSIGN(AdaptiveStrategy);
+};
+
+template <int64_t SpinNanos, int64_t YieldNanos, typename D, int DV>
+constexpr int AdaptiveStrategy<SpinNanos, YieldNanos, D, DV>::kSmoothingShift;
+template <int64_t SpinNanos, int64_t YieldNanos, typename D, int DV>
+constexpr int64_t
+    AdaptiveStrategy<SpinNanos, YieldNanos, D, DV>::kClockSampleRounds;
+
 static inline std::function<int64_t()> buildMinSequenceFunction(
     const Sequence& cursor, const std::vector<Sequence*>& dependents) {
   if (!dependents.size())
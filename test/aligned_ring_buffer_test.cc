@@ -0,0 +1,111 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE AlignedRingBufferTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <disruptor/aligned_ring_buffer.h>
+#include <disruptor/sequencer.h>
+
+#define RING_BUFFER_SIZE 8
+
+namespace disruptor {
+namespace test {
+
+template <size_t A>
+static size_t SlotStride(const RingBuffer<Aligned<int64_t, A>,
+                                          RING_BUFFER_SIZE>& ring_buffer) {
+  return reinterpret_cast<uintptr_t>(&ring_buffer[1]) -
+         reinterpret_cast<uintptr_t>(&ring_buffer[0]);
+}
+
+BOOST_AUTO_TEST_SUITE(AlignedRingBufferBasic)
+
+BOOST_AUTO_TEST_CASE(ShouldPackSlots) {
+  RingBuffer<Aligned<int64_t, kPackedSlots>, RING_BUFFER_SIZE> ring_buffer;
+  BOOST_CHECK_EQUAL(SlotStride(ring_buffer), sizeof(int64_t));
+}
+
+BOOST_AUTO_TEST_CASE(ShouldAlignSlotsOnLines) {
+  RingBuffer<Aligned<int64_t, kLineAlignedSlots>, RING_BUFFER_SIZE>
+      ring_buffer;
+  BOOST_CHECK_EQUAL(SlotStride(ring_buffer), kLineAlignedSlots);
+  for (int64_t i = 0; i < RING_BUFFER_SIZE; i++)
+    BOOST_CHECK_EQUAL(
+        reinterpret_cast<uintptr_t>(&ring_buffer[i]) % kLineAlignedSlots, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldAlignSlotsOnLinePairs) {
+  RingBuffer<Aligned<int64_t, kLinePairAlignedSlots>, RING_BUFFER_SIZE>
+      ring_buffer;
+  BOOST_CHECK_EQUAL(SlotStride(ring_buffer), kLinePairAlignedSlots);
+  for (int64_t i = 0; i < RING_BUFFER_SIZE; i++)
+    BOOST_CHECK_EQUAL(
+        reinterpret_cast<uintptr_t>(&ring_buffer[i]) % kLinePairAlignedSlots,
+        0);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldWrapAroundSlots) {
+  RingBuffer<Aligned<int64_t>, RING_BUFFER_SIZE> ring_buffer;
+  for (int64_t i = 0; i < RING_BUFFER_SIZE; i++)
+    BOOST_CHECK_EQUAL(ring_buffer[i], 0L);
+
+  for (int64_t i = 0; i < RING_BUFFER_SIZE * 2; i++) ring_buffer[i] = i;
+  for (int64_t i = 0; i < RING_BUFFER_SIZE; i++) {
+    BOOST_CHECK_EQUAL(ring_buffer[i], i + RING_BUFFER_SIZE);
+    BOOST_CHECK_EQUAL(&ring_buffer[i], &ring_buffer[i + RING_BUFFER_SIZE]);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(AlignedSequencer)
+
+BOOST_AUTO_TEST_CASE(ClaimAndPublish) {
+  Sequencer<Aligned<int64_t>, RING_BUFFER_SIZE,
+            SingleThreadedStrategy<RING_BUFFER_SIZE>, kDefaultWaitStrategy>
+      sequencer;
+  Sequence consumer_sequence;
+  sequencer.set_gating_sequences({&consumer_sequence});
+
+  for (int64_t i = 0; i < RING_BUFFER_SIZE; i++) {
+    const int64_t sequence = sequencer.Claim();
+    BOOST_CHECK_EQUAL(sequence, i);
+    sequencer[sequence] = i * 10;
+    sequencer.Publish(sequence);
+  }
+
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), RING_BUFFER_SIZE - 1);
+  BOOST_CHECK(!sequencer.HasAvailableCapacity());
+  for (int64_t i = 0; i < RING_BUFFER_SIZE; i++)
+    BOOST_CHECK_EQUAL(sequencer[i], i * 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
@@ -0,0 +1,173 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE AwaitableBarrierTest
+
+#include <deque>
+#include <exception>
+
+#include <boost/test/unit_test.hpp>
+
+#include <disruptor/awaitable_barrier.h>
+#include <disruptor/sequencer.h>
+
+#define RING_BUFFER_SIZE 8
+
+namespace disruptor {
+namespace test {
+
+// Minimal eagerly started coroutine.
+struct StubTask {
+  struct promise_type {
+    StubTask get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+// Consume `count` events, recording the value returned by every await.
+StubTask Consume(AwaitableBarrier& barrier, int64_t count,
+                 std::vector<int64_t>& results) {
+  int64_t next_sequence = kFirstSequenceValue;
+  while (next_sequence < count) {
+    const int64_t available = co_await barrier.wait_for(next_sequence);
+    results.push_back(available);
+    if (available == kAlertedSignal) co_return;
+    next_sequence = available + 1L;
+  }
+}
+
+using StubSequencer =
+    Sequencer<int64_t, RING_BUFFER_SIZE,
+              SingleThreadedStrategy<RING_BUFFER_SIZE>, CoroutineStrategy>;
+
+struct AwaitableBarrierFixture {
+  AwaitableBarrierFixture()
+      : sequencer(std::array<int64_t, RING_BUFFER_SIZE>{}),
+        barrier(sequencer.cursor(), dependents, sequencer.wait_strategy()) {}
+
+  void PublishEvents(int64_t count) {
+    const int64_t sequence = sequencer.Claim(count);
+    sequencer.Publish(sequence, count);
+  }
+
+  std::vector<Sequence*> dependents;
+  StubSequencer sequencer;
+  AwaitableBarrier barrier;
+  std::vector<int64_t> results;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AwaitableBarrierBasic, AwaitableBarrierFixture)
+
+BOOST_AUTO_TEST_CASE(ShouldNotSuspendWhenAvailable) {
+  PublishEvents(2);
+  Consume(barrier, 2, results);
+  BOOST_REQUIRE_EQUAL(results.size(), 1);
+  BOOST_CHECK_EQUAL(results[0], 1L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldResumeOnPublish) {
+  Consume(barrier, 3, results);
+  BOOST_CHECK(results.empty());
+
+  PublishEvents(1);
+  BOOST_REQUIRE_EQUAL(results.size(), 1);
+  BOOST_CHECK_EQUAL(results[0], 0L);
+
+  PublishEvents(2);
+  BOOST_REQUIRE_EQUAL(results.size(), 2);
+  BOOST_CHECK_EQUAL(results[1], 2L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldResumeOnAlert) {
+  Consume(barrier, 3, results);
+  BOOST_CHECK(results.empty());
+
+  barrier.set_alerted(true);
+  BOOST_REQUIRE_EQUAL(results.size(), 1);
+  BOOST_CHECK_EQUAL(results[0], kAlertedSignal);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldWaitOnDependents) {
+  Sequence upstream;
+  AwaitableBarrier downstream(sequencer.cursor(), {&upstream},
+                              sequencer.wait_strategy());
+  Consume(downstream, 1, results);
+
+  PublishEvents(1);
+  BOOST_CHECK(results.empty());
+
+  upstream.set_sequence(0L);
+  sequencer.wait_strategy().SignalAllWhenBlocking();
+  BOOST_REQUIRE_EQUAL(results.size(), 1);
+  BOOST_CHECK_EQUAL(results[0], 0L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldResumeManyCoroutinesThroughScheduler) {
+  const int kCoroutines = 1000;
+  std::deque<std::coroutine_handle<>> run_queue;
+  sequencer.wait_strategy().set_scheduler(
+      [&run_queue](std::coroutine_handle<> handle) {
+        run_queue.push_back(handle);
+      });
+
+  std::vector<std::vector<int64_t>> all_results(kCoroutines);
+  for (auto& coroutine_results : all_results)
+    Consume(barrier, 1, coroutine_results);
+
+  PublishEvents(1);
+  BOOST_CHECK_EQUAL(run_queue.size(), kCoroutines);
+  for (const auto& coroutine_results : all_results)
+    BOOST_CHECK(coroutine_results.empty());
+
+  while (!run_queue.empty()) {
+    run_queue.front().resume();
+    run_queue.pop_front();
+  }
+  for (const auto& coroutine_results : all_results) {
+    BOOST_REQUIRE_EQUAL(coroutine_results.size(), 1);
+    BOOST_CHECK_EQUAL(coroutine_results[0], 0L);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ShouldResumeFromPublisherThread) {
+  Consume(barrier, RING_BUFFER_SIZE * 4, results);
+
+  std::thread publisher([this]() {
+    for (int64_t i = 0; i < RING_BUFFER_SIZE * 4; i++) PublishEvents(1);
+  });
+  publisher.join();
+
+  BOOST_REQUIRE(!results.empty());
+  BOOST_CHECK_EQUAL(results.back(), RING_BUFFER_SIZE * 4 - 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
@@ -0,0 +1,141 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE BatchProgressTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <disruptor/batch_progress.h>
+#include <disruptor/event_poller.h>
+#include <disruptor/sequencer.h>
+
+#define RING_BUFFER_SIZE 8
+
+namespace disruptor {
+namespace test {
+
+struct BatchProgressFixture {
+  BatchProgressFixture() : progress(sequence, 3) {}
+
+  Sequence sequence;
+  BatchProgress progress;
+};
+
+BOOST_FIXTURE_TEST_SUITE(BatchProgressBasic, BatchProgressFixture)
+
+BOOST_AUTO_TEST_CASE(ShouldPublishEveryInterval) {
+  progress.Processed(0L);
+  progress.Processed(1L);
+  BOOST_CHECK_EQUAL(sequence.sequence(), kInitialCursorValue);
+  BOOST_CHECK_EQUAL(progress.processed(), 1L);
+
+  progress.Processed(2L);
+  BOOST_CHECK_EQUAL(sequence.sequence(), 2L);
+  BOOST_CHECK_EQUAL(progress.published(), 2L);
+
+  progress.Processed(3L);
+  BOOST_CHECK_EQUAL(sequence.sequence(), 2L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldPublishOnDemand) {
+  progress.Processed(0L);
+  progress.Publish();
+  BOOST_CHECK_EQUAL(sequence.sequence(), 0L);
+
+  progress.Processed(1L);
+  progress.Processed(2L);
+  progress.Processed(3L);
+  BOOST_CHECK_EQUAL(sequence.sequence(), 3L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldResynchronizeOnReset) {
+  sequence.set_sequence(10L);
+  progress.Reset();
+  BOOST_CHECK_EQUAL(progress.processed(), 10L);
+  BOOST_CHECK_EQUAL(progress.published(), 10L);
+
+  progress.Processed(13L);
+  BOOST_CHECK_EQUAL(sequence.sequence(), 13L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldPublishWhenRequested) {
+  Sequence requested;
+  BatchProgress deferred(sequence, kProgressAtEndOfBatch, &requested);
+
+  deferred.Processed(0L);
+  deferred.Processed(1L);
+  BOOST_CHECK(!deferred.Requested());
+  BOOST_CHECK_EQUAL(sequence.sequence(), kInitialCursorValue);
+
+  // a publisher waits for the consumer to reach 3.
+  requested.set_sequence(3L);
+  BOOST_CHECK(deferred.Requested());
+  deferred.Processed(2L);
+  BOOST_CHECK_EQUAL(sequence.sequence(), 2L);
+  deferred.Processed(3L);
+  BOOST_CHECK_EQUAL(sequence.sequence(), 3L);
+
+  deferred.Processed(4L);
+  BOOST_CHECK(!deferred.Requested());
+  BOOST_CHECK_EQUAL(sequence.sequence(), 3L);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(BatchProgressPoller)
+
+BOOST_AUTO_TEST_CASE(ShouldReleasePublisherWithinBatch) {
+  using StubSequencer =
+      Sequencer<int64_t, RING_BUFFER_SIZE,
+                SingleThreadedStrategy<RING_BUFFER_SIZE>, kDefaultWaitStrategy>;
+  StubSequencer sequencer(std::array<int64_t, RING_BUFFER_SIZE>{});
+  EventPoller<StubSequencer> poller(sequencer, {}, 3);
+  sequencer.set_gating_sequences({&poller.sequence()});
+
+  const int64_t last = sequencer.Claim(RING_BUFFER_SIZE);
+  sequencer.Publish(last, RING_BUFFER_SIZE);
+
+  std::vector<int64_t> published;
+  std::vector<bool> capacity;
+  poller.Poll([&](int64_t&, int64_t sequence, bool) {
+    published.push_back(poller.sequence().sequence());
+    capacity.push_back(sequencer.HasAvailableCapacity());
+    if (sequence == 4L) poller.progress().Publish();
+    return true;
+  });
+
+  std::vector<int64_t> expected = {-1, -1, -1, 2, 2, 3, 3, 6};
+  BOOST_CHECK_EQUAL_COLLECTIONS(published.begin(), published.end(),
+                                expected.begin(), expected.end());
+  BOOST_CHECK(!capacity[0]);
+  BOOST_CHECK(capacity[3]);
+  BOOST_CHECK_EQUAL(poller.sequence().sequence(), RING_BUFFER_SIZE - 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
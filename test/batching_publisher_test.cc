@@ -0,0 +1,136 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE BatchingPublisherTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include <disruptor/batching_publisher.h>
+#include <disruptor/sequencer.h>
+
+#define RING_BUFFER_SIZE 8
+
+namespace disruptor {
+namespace test {
+
+using StubSequencer =
+    Sequencer<int64_t, RING_BUFFER_SIZE,
+              SingleThreadedStrategy<RING_BUFFER_SIZE>, kDefaultWaitStrategy>;
+
+struct BatchingPublisherFixture {
+  BatchingPublisherFixture()
+      : sequencer(std::array<int64_t, RING_BUFFER_SIZE>{}) {
+    sequencer.set_gating_sequences({&consumer_sequence});
+  }
+
+  template <typename P>
+  void PublishEvents(P& publisher, int64_t count) {
+    for (int64_t i = 0; i < count; i++) {
+      const int64_t sequence = publisher.Claim();
+      publisher[sequence] = sequence;
+      publisher.Publish(sequence);
+    }
+  }
+
+  StubSequencer sequencer;
+  Sequence consumer_sequence;
+};
+
+BOOST_FIXTURE_TEST_SUITE(BatchingPublisherBasic, BatchingPublisherFixture)
+
+BOOST_AUTO_TEST_CASE(ShouldPublishFullBatch) {
+  BatchingPublisher<StubSequencer> publisher(sequencer, 4,
+                                             std::chrono::seconds(60));
+
+  PublishEvents(publisher, 3);
+  BOOST_CHECK_EQUAL(publisher.pending(), 3);
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), kInitialCursorValue);
+
+  PublishEvents(publisher, 1);
+  BOOST_CHECK_EQUAL(publisher.pending(), 0);
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), 3L);
+  BOOST_CHECK_EQUAL(sequencer[3], 3L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldPublishBatchPastDeadline) {
+  BatchingPublisher<StubSequencer> publisher(sequencer, 4,
+                                             std::chrono::microseconds(1000));
+
+  PublishEvents(publisher, 1);
+  BOOST_CHECK(!publisher.Poll());
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), kInitialCursorValue);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  BOOST_CHECK(publisher.Poll());
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), 0L);
+  BOOST_CHECK(!publisher.Poll());
+
+  // an event committed past the deadline publishes its batch.
+  PublishEvents(publisher, 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  PublishEvents(publisher, 1);
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), 2L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldFlushOnDemandAndOnDestruction) {
+  {
+    BatchingPublisher<StubSequencer> publisher(sequencer, 4,
+                                               std::chrono::seconds(60));
+    PublishEvents(publisher, 2);
+    publisher.Flush();
+    BOOST_CHECK_EQUAL(sequencer.GetCursor(), 1L);
+
+    PublishEvents(publisher, 1);
+    BOOST_CHECK_EQUAL(sequencer.GetCursor(), 1L);
+  }
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), 2L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldFlushBeforeWaitingForConsumers) {
+  BatchingPublisher<StubSequencer> publisher(sequencer, RING_BUFFER_SIZE * 2,
+                                             std::chrono::seconds(60));
+  PublishEvents(publisher, RING_BUFFER_SIZE);
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), kInitialCursorValue);
+
+  // the consumer only moves once the full ring is published.
+  auto barrier = sequencer.NewBarrier(std::vector<Sequence*>());
+  std::thread consumer([this, &barrier]() {
+    consumer_sequence.set_sequence(barrier->WaitFor(RING_BUFFER_SIZE - 1));
+  });
+
+  BOOST_CHECK_EQUAL(publisher.Claim(), RING_BUFFER_SIZE);
+  consumer.join();
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), RING_BUFFER_SIZE - 1);
+  BOOST_CHECK_EQUAL(consumer_sequence.sequence(), RING_BUFFER_SIZE - 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
@@ -0,0 +1,115 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <disruptor/pipeline.h>
+#include <disruptor/sequencer.h>
+
+using namespace disruptor;
+
+constexpr size_t kBufferSize = 1024 * 8;
+constexpr int64_t kFirstEvents = 1000L * 10;
+constexpr int64_t kWarmUpCycles = 1000L * 1000L;
+
+struct StubEvent {
+  int64_t published_nanos;
+  bool synthetic;
+  int64_t payload[6];
+};
+
+static int64_t NowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Record the publish to handle latency of every real event.
+struct LatencyHandler {
+  LatencyHandler() : sum(0) { latencies.reserve(kFirstEvents); }
+
+  void operator()(StubEvent& event, int64_t sequence, bool end_of_batch) {
+    for (const int64_t word : event.payload) sum += word;
+    if (!event.synthetic)
+      latencies.push_back(NowNanos() - event.published_nanos);
+  }
+
+  std::vector<int64_t> latencies;
+  int64_t sum;
+};
+
+// Publish the first kFirstEvents events of a fresh topology one at a time,
+// after `warm_up_cycles` synthetic events.
+static void Run(const std::string& name, int64_t warm_up_cycles) {
+  using StubSequencer = Sequencer<StubEvent, kBufferSize,
+                                  SingleThreadedStrategy<kBufferSize>,
+                                  BusySpinStrategy>;
+  using Unicast =
+      Pipeline<StubSequencer, BusySpinStrategy, Stage<LatencyHandler>>;
+
+  std::unique_ptr<StubSequencer> sequencer(
+      new StubSequencer(std::array<StubEvent, kBufferSize>()));
+  LatencyHandler handler;
+  Unicast pipeline(*sequencer, handler);
+
+  if (warm_up_cycles)
+    pipeline.WarmUp(warm_up_cycles,
+                    [](StubEvent& event) { event.synthetic = true; });
+  pipeline.Start();
+
+  for (int64_t i = 0; i < kFirstEvents; i++) {
+    const int64_t sequence = sequencer->Claim();
+    StubEvent& event = (*sequencer)[sequence];
+    event.synthetic = false;
+    event.payload[0] = i;
+    event.published_nanos = NowNanos();
+    sequencer->Publish(sequence);
+    while (pipeline.sequence<0>().sequence() < sequence) {
+    }
+  }
+  pipeline.Halt();
+
+  std::vector<int64_t>& latencies = handler.latencies;
+  const int64_t first = latencies.front();
+  std::sort(latencies.begin(), latencies.end());
+  int64_t total = 0;
+  for (const int64_t latency : latencies) total += latency;
+
+  std::cout << name << " first event: " << first << " ns, mean: "
+            << total / static_cast<int64_t>(latencies.size())
+            << " ns, p99: " << latencies[latencies.size() * 99 / 100]
+            << " ns, max: " << latencies.back() << " ns" << std::endl;
+}
+
+int main(int arc, char** argv) {
+  Run("1P-1EP-COLD", 0);
+  Run("1P-1EP-WARMED-UP", kWarmUpCycles);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,186 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <sys/time.h>
+
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <disruptor/sequencer.h>
+#include <disruptor/sharded_sequencer.h>
+
+using namespace disruptor;
+
+constexpr size_t kBufferSize = 1024 * 16;
+constexpr int64_t kIterations = 1000L * 1000L * 20;
+constexpr size_t kLeaseSize = 64;
+
+static double Now() {
+  struct timeval time;
+  gettimeofday(&time, NULL);
+  return time.tv_sec + ((double)time.tv_usec / 1000000);
+}
+
+// P producers contending on a MultiThreadedStrategy sequencer.
+double RunMultiThreaded(size_t producers) {
+  using MultiSequencer = Sequencer<int64_t, kBufferSize,
+                                   MultiThreadedStrategy<kBufferSize>,
+                                   BusySpinStrategy>;
+  std::unique_ptr<MultiSequencer> sequencer(
+      new MultiSequencer(std::array<int64_t, kBufferSize>()));
+  const int64_t per_producer = kIterations / producers;
+  const int64_t expected_sequence = per_producer * producers - 1;
+
+  Sequence consumer_sequence;
+  sequencer->set_gating_sequences({&consumer_sequence});
+  auto barrier = sequencer->NewBarrier(std::vector<Sequence*>());
+
+  std::thread consumer([&]() {
+    int64_t sum = 0;
+    int64_t next_sequence = kFirstSequenceValue;
+    while (next_sequence <= expected_sequence) {
+      const int64_t available = barrier->WaitFor(next_sequence);
+      for (; next_sequence <= available; next_sequence++)
+        sum += (*sequencer)[next_sequence];
+      consumer_sequence.set_sequence(available);
+    }
+  });
+
+  const double start = Now();
+  std::vector<std::thread> publishers;
+  for (size_t p = 0; p < producers; p++)
+    publishers.emplace_back([&]() {
+      for (int64_t i = 0; i < per_producer; i++) {
+        const int64_t sequence = sequencer->Claim();
+        (*sequencer)[sequence] = i;
+        sequencer->Publish(sequence);
+      }
+    });
+  for (auto& publisher : publishers) publisher.join();
+  consumer.join();
+  const double end = Now();
+
+  return (per_producer * producers) / (end - start);
+}
+
+// P producers claiming leases of kLeaseSize sequences from a
+// MultiThreadedStrategy sequencer.
+double RunLeased(size_t producers) {
+  using LeasedSequencer =
+      Sequencer<int64_t, kBufferSize,
+                MultiThreadedStrategy<kBufferSize, kLeaseSize>,
+                BusySpinStrategy>;
+  std::unique_ptr<LeasedSequencer> sequencer(
+      new LeasedSequencer(std::array<int64_t, kBufferSize>()));
+  const int64_t per_producer = kIterations / producers;
+  const int64_t expected_sequence = per_producer * producers - 1;
+
+  Sequence consumer_sequence;
+  sequencer->set_gating_sequences({&consumer_sequence});
+  auto barrier = sequencer->NewBarrier(std::vector<Sequence*>());
+
+  std::thread consumer([&]() {
+    int64_t sum = 0;
+    int64_t next_sequence = kFirstSequenceValue;
+    while (next_sequence <= expected_sequence) {
+      const int64_t available = barrier->WaitFor(next_sequence);
+      for (; next_sequence <= available; next_sequence++)
+        sum += (*sequencer)[next_sequence];
+      consumer_sequence.set_sequence(available);
+    }
+  });
+
+  const double start = Now();
+  std::vector<std::thread> publishers;
+  for (size_t p = 0; p < producers; p++)
+    publishers.emplace_back([&]() {
+      SequenceLease lease;
+      for (int64_t i = 0; i < per_producer; i++) {
+        const int64_t sequence = sequencer->Claim(lease);
+        (*sequencer)[sequence] = i;
+        sequencer->Publish(sequence);
+      }
+      sequencer->ReleaseLease(lease, [](int64_t& event) { event = 0; });
+    });
+  for (auto& publisher : publishers) publisher.join();
+  consumer.join();
+  const double end = Now();
+
+  return (per_producer * producers) / (end - start);
+}
+
+// P producers each owning a single producer lane, merged by one consumer.
+double RunSharded(size_t producers) {
+  using Sharded = ShardedSequencer<int64_t, kBufferSize, BusySpinStrategy>;
+  std::unique_ptr<Sharded> sequencer(new Sharded(producers));
+  const int64_t per_producer = kIterations / producers;
+
+  std::thread consumer([&]() {
+    int64_t sum = 0;
+    sequencer->Run([&sum](size_t, int64_t& event, int64_t, bool) {
+      sum += event;
+    });
+  });
+
+  const double start = Now();
+  std::vector<std::thread> publishers;
+  for (size_t p = 0; p < producers; p++)
+    publishers.emplace_back([&sequencer, p, per_producer]() {
+      auto& lane = sequencer->lane(p);
+      for (int64_t i = 0; i < per_producer; i++) {
+        const int64_t sequence = lane.Claim();
+        lane[sequence] = i;
+        lane.Publish(sequence);
+      }
+    });
+  for (auto& publisher : publishers) publisher.join();
+  for (size_t p = 0; p < producers; p++)
+    while (sequencer->sequence(p).sequence() < per_producer - 1) {
+    }
+  const double end = Now();
+
+  sequencer->set_alerted(true);
+  consumer.join();
+
+  return (per_producer * producers) / (end - start);
+}
+
+int main(int arc, char** argv) {
+  std::cout.precision(15);
+  for (size_t producers = 2; producers <= 16; producers *= 2) {
+    std::cout << producers << "P-1EP-MULTI-THREADED performance: ";
+    std::cout << RunMultiThreaded(producers) << " ops/secs" << std::endl;
+
+    std::cout << producers << "P-1EP-LEASED performance: ";
+    std::cout << RunLeased(producers) << " ops/secs" << std::endl;
+
+    std::cout << producers << "P-1EP-SHARDED performance: ";
+    std::cout << RunSharded(producers) << " ops/secs" << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,114 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <sys/time.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+#include <disruptor/batching_publisher.h>
+#include <disruptor/pipeline.h>
+#include <disruptor/sequencer.h>
+
+using namespace disruptor;
+
+constexpr size_t kBufferSize = 1024 * 8;
+constexpr int64_t kIterations = 1000L * 1000L * 100;
+constexpr size_t kBatchSize = 64;
+
+using StubSequencer =
+    Sequencer<int64_t, kBufferSize, SingleThreadedStrategy<kBufferSize>,
+              BusySpinStrategy>;
+
+struct StubHandler {
+  StubHandler() : sum(0) {}
+
+  void operator()(int64_t& event, int64_t sequence, bool end_of_batch) {
+    sum += event;
+  }
+
+  int64_t sum;
+};
+
+static double Now() {
+  struct timeval time;
+  gettimeofday(&time, NULL);
+  return time.tv_sec + ((double)time.tv_usec / 1000000);
+}
+
+// One publisher to one consumer, publishing through a P
+// constructed with `args`.
+template <typename P, typename... Args>
+double Run(Args... args) {
+  using Unicast =
+      Pipeline<StubSequencer, BusySpinStrategy, Stage<StubHandler>>;
+
+  std::unique_ptr<StubSequencer> sequencer(
+      new StubSequencer(std::array<int64_t, kBufferSize>()));
+  StubHandler handler;
+  Unicast pipeline(*sequencer, handler);
+  pipeline.Start();
+
+  const double start = Now();
+  {
+    P publisher(*sequencer, args...);
+    for (int64_t i = 0; i < kIterations; i++) {
+      const int64_t sequence = publisher.Claim();
+      publisher[sequence] = i;
+      publisher.Publish(sequence);
+    }
+  }
+  while (pipeline.sequence<0>().sequence() < kIterations - 1) {
+  }
+  const double end = Now();
+
+  pipeline.Halt();
+  return kIterations / (end - start);
+}
+
+// Publishes every event as it is committed.
+struct EachEventPublisher {
+  EachEventPublisher(StubSequencer& sequencer) : sequencer(sequencer) {}
+
+  int64_t Claim() { return sequencer.Claim(); }
+  int64_t& operator[](const int64_t& sequence) { return sequencer[sequence]; }
+  void Publish(const int64_t& sequence) { sequencer.Publish(sequence); }
+
+  StubSequencer& sequencer;
+};
+
+int main(int arc, char** argv) {
+  std::cout.precision(15);
+  std::cout << "1P-1EP-EACH-EVENT performance: ";
+  std::cout << Run<EachEventPublisher>() << " ops/secs" << std::endl;
+
+  std::cout << "1P-1EP-BATCHING performance: ";
+  std::cout << Run<BatchingPublisher<StubSequencer>>(
+                   kBatchSize, std::chrono::microseconds(10))
+            << " ops/secs" << std::endl;
+
+  return EXIT_SUCCESS;
+}
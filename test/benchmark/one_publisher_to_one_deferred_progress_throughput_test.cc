@@ -0,0 +1,94 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <sys/time.h>
+
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <disruptor/event_poller.h>
+#include <disruptor/sequencer.h>
+
+using namespace disruptor;
+
+constexpr size_t kBufferSize = 1024 * 64;
+constexpr int64_t kIterations = 1000L * 1000L * 100;
+constexpr int64_t kDeferredInterval = 1024L;
+
+using StubSequencer = Sequencer<int64_t, kBufferSize,
+                                SingleThreadedStrategy<kBufferSize>,
+                                BusySpinStrategy>;
+
+static double Now() {
+  struct timeval time;
+  gettimeofday(&time, NULL);
+  return time.tv_sec + ((double)time.tv_usec / 1000000);
+}
+
+// One publisher of 8 bytes events to one polling consumer.
+double Run(int64_t progress_interval, ProgressPolicy policy) {
+  std::unique_ptr<StubSequencer> sequencer(
+      new StubSequencer(std::array<int64_t, kBufferSize>()));
+  EventPoller<StubSequencer> poller(*sequencer, std::vector<Sequence*>(),
+                                    progress_interval, policy);
+  sequencer->set_gating_sequences({&poller.sequence()});
+
+  int64_t sum = 0;
+  int64_t consumed = 0;
+  std::thread consumer([&]() {
+    while (consumed < kIterations)
+      poller.Poll([&](int64_t& event, int64_t, bool) {
+        sum += event;
+        consumed++;
+        return true;
+      });
+  });
+
+  const double start = Now();
+  for (int64_t i = 0; i < kIterations; i++) {
+    const int64_t sequence = sequencer->Claim();
+    (*sequencer)[sequence] = i;
+    sequencer->Publish(sequence);
+  }
+  consumer.join();
+  const double end = Now();
+
+  return kIterations / (end - start);
+}
+
+int main(int arc, char** argv) {
+  std::cout.precision(15);
+  std::cout << "1P-1EP-END-OF-BATCH performance: ";
+  std::cout << Run(kProgressAtEndOfBatch, ProgressPolicy::kEndOfBatch)
+            << " ops/secs" << std::endl;
+
+  std::cout << "1P-1EP-DEFERRED performance: ";
+  std::cout << Run(kDeferredInterval, ProgressPolicy::kDeferred)
+            << " ops/secs" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -1,4 +1,4 @@
-// Copyright (c) 2011-2015, François Saint-Jacques
+// Copyright (c) 2011-2015, Francois Saint-Jacques
 // All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -12,114 +12,104 @@
 //       names of its contributors may be used to endorse or promote products
 //       derived from this software without specific prior written permission.
 //
-// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
-// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
-// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
-// DISCLAIMED. IN NO EVENT SHALL FRANÇOIS SAINT-JACQUES BE LIABLE FOR ANY
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
 // DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
 // (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
 // LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
 // ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
-// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <sys/time.h>
 
-#include <exception>
-#include <functional>
 #include <iostream>
 #include <memory>
-#include <thread>
+#include <string>
 
-#include <disruptor/ring_buffer.h>
-#include <disruptor/event_publisher.h>
-#include <disruptor/event_processor.h>
-#include <disruptor/exception_handler.h>
-
-#include "../test/support/stub_event.h"
+#include <disruptor/pipeline.h>
+#include <disruptor/sequencer.h>
 
 using namespace disruptor;
 
-int main(int arc, char** argv) {
-    int buffer_size = 1024 * 8;
-    long iterations = 1000L * 1000L * 300;
-
-    test::StubEventFactory stub_factory;
-    RingBuffer<test::StubEvent> ring_buffer(&stub_factory,
-                                       buffer_size,
-                                       kSingleThreadedStrategy,
-                                       kBusySpinStrategy);
-
-    // one exception handler
-    IgnoreExceptionHandler<test::StubEvent> stub_exception_handler;
-    // one event handler
-    test::StubBatchHandler stub_handler;
-
-    std::vector<Sequence*> sequence_to_track(0);
-
-    std::unique_ptr<ProcessingSequenceBarrier> first_barrier(
-        ring_buffer.NewBarrier(sequence_to_track));
-    BatchEventProcessor<test::StubEvent> first_processor(&ring_buffer,
-                                              (SequenceBarrierInterface*) first_barrier.get(),
-                                              &stub_handler,
-                                              &stub_exception_handler);
-
-    sequence_to_track.clear();
-    sequence_to_track.push_back(first_processor.GetSequence());
-
-    std::unique_ptr<ProcessingSequenceBarrier> second_barrier(
-        ring_buffer.NewBarrier(sequence_to_track));
-    BatchEventProcessor<test::StubEvent> second_processor(&ring_buffer,
-                                              (SequenceBarrierInterface*) second_barrier.get(),
-                                              &stub_handler,
-                                              &stub_exception_handler);
-    sequence_to_track.clear();
-    sequence_to_track.push_back(second_processor.GetSequence());
-
-    std::unique_ptr<ProcessingSequenceBarrier> third_barrier(
-        ring_buffer.NewBarrier(sequence_to_track));
-    BatchEventProcessor<test::StubEvent> third_processor(&ring_buffer,
-                                              (SequenceBarrierInterface*) third_barrier.get(),
-                                              &stub_handler,
-                                              &stub_exception_handler);
-
-
-    std::thread first_consumer(std::ref<BatchEventProcessor<test::StubEvent>>(first_processor));
-    std::thread second_consumer(std::ref<BatchEventProcessor<test::StubEvent>>(second_processor));
-    std::thread third_consumer(std::ref<BatchEventProcessor<test::StubEvent>>(third_processor));
-
-    struct timeval start_time, end_time;
-
-    gettimeofday(&start_time, NULL);
-
-    std::unique_ptr<test::StubEventTranslator> translator(new test::StubEventTranslator);
-    EventPublisher<test::StubEvent> publisher(&ring_buffer);
-    for (long i=0; i<iterations; i++) {
-        publisher.PublishEvent(translator.get());
-    }
-
-    long expected_sequence = ring_buffer.GetCursor();
-    while (third_processor.GetSequence()->sequence() < expected_sequence) {}
-
-    gettimeofday(&end_time, NULL);
-
-    double start, end;
-    start = start_time.tv_sec + ((double) start_time.tv_usec / 1000000);
-    end = end_time.tv_sec + ((double) end_time.tv_usec / 1000000);
-
-    std::cout.precision(15);
-    std::cout << "1P-3EP-PIPELINE performance: ";
-    std::cout << (iterations * 1.0) / (end - start)
-              << " ops/secs" << std::endl;
-
-    first_processor.Halt();
-    second_processor.Halt();
-    third_processor.Halt();
-
-    first_consumer.join();
-    second_consumer.join();
-    third_consumer.join();
-
-    return EXIT_SUCCESS;
+constexpr size_t kBufferSize = 1024;
+constexpr int64_t kIterations = 1000L * 1000L * 10;
+constexpr int64_t kPrefetchDistance = 4L;
+
+// Event of Size bytes, read entirely by every stage.
+template <size_t Size>
+struct StubEvent {
+  int64_t words[Size / sizeof(int64_t)];
+};
+
+struct StubHandler {
+  StubHandler() : sum(0) {}
+
+  template <typename E>
+  void operator()(E& event, int64_t sequence, bool end_of_batch) {
+    for (const int64_t word : event.words) sum += word;
+  }
+
+  int64_t sum;
+};
+
+static double Now() {
+  struct timeval time;
+  gettimeofday(&time, NULL);
+  return time.tv_sec + ((double)time.tv_usec / 1000000);
 }
 
+// One publisher to three chained stages, all prefetching
+// `prefetch_distance` events ahead.
+template <size_t Size>
+double Run(int64_t prefetch_distance) {
+  using Event = StubEvent<Size>;
+  using StubSequencer = Sequencer<Event, kBufferSize,
+                                  SingleThreadedStrategy<kBufferSize>,
+                                  BusySpinStrategy>;
+  using ThreeStages =
+      Pipeline<StubSequencer, BusySpinStrategy, Stage<StubHandler>,
+               Stage<StubHandler, 0>, Stage<StubHandler, 1>>;
+
+  std::unique_ptr<StubSequencer> sequencer(
+      new StubSequencer(std::array<Event, kBufferSize>()));
+  StubHandler first;
+  StubHandler second;
+  StubHandler third;
+  ThreeStages pipeline(*sequencer, first, second, third);
+  sequencer->set_prefetch_distance(prefetch_distance);
+  pipeline.set_prefetch_distance(prefetch_distance);
+  pipeline.Start();
+
+  const double start = Now();
+  for (int64_t i = 0; i < kIterations; i++) {
+    const int64_t sequence = sequencer->Claim();
+    (*sequencer)[sequence].words[0] = i;
+    sequencer->Publish(sequence);
+  }
+  while (pipeline.template sequence<2>().sequence() < kIterations - 1) {
+  }
+  const double end = Now();
+
+  pipeline.Halt();
+  return kIterations / (end - start);
+}
+
+template <size_t Size>
+void Report(const std::string& name) {
+  std::cout << "1P-3EP-PIPELINE-" << name << " performance: ";
+  std::cout << Run<Size>(kNoPrefetch) << " ops/secs" << std::endl;
+
+  std::cout << "1P-3EP-PIPELINE-" << name << "-PREFETCH performance: ";
+  std::cout << Run<Size>(kPrefetchDistance) << " ops/secs" << std::endl;
+}
+
+int main(int arc, char** argv) {
+  std::cout.precision(15);
+  Report<256>("256B");
+  Report<1024>("1KB");
+
+  return EXIT_SUCCESS;
+}
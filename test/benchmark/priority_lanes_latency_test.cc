@@ -0,0 +1,120 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <disruptor/fan_in.h>
+#include <disruptor/sequencer.h>
+
+using namespace disruptor;
+
+constexpr size_t kBufferSize = 1024 * 64;
+constexpr int64_t kControlEvents = 1000L * 10;
+constexpr int64_t kControlInterval = 10000L;
+constexpr size_t kControl = 0;
+constexpr size_t kBulk = 1;
+
+using StubSequencer = Sequencer<int64_t, kBufferSize,
+                                SingleThreadedStrategy<kBufferSize>,
+                                BusySpinStrategy>;
+
+static int64_t NowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void Publish(StubSequencer& sequencer, int64_t value) {
+  const int64_t sequence = sequencer.Claim();
+  sequencer[sequence] = value;
+  sequencer.Publish(sequence);
+}
+
+// Latency of control events published every kControlInterval nanoseconds
+// while a bulk publisher saturates its own ring.
+static void Run(const std::string& name, const std::vector<int64_t>& batches,
+                FanInPriority priority) {
+  std::unique_ptr<StubSequencer> control(
+      new StubSequencer(std::array<int64_t, kBufferSize>()));
+  std::unique_ptr<StubSequencer> bulk(
+      new StubSequencer(std::array<int64_t, kBufferSize>()));
+  FanInConsumer<StubSequencer, BusySpinStrategy> consumer(
+      {control.get(), bulk.get()}, batches, priority);
+  control->set_gating_sequences({&consumer.sequence(kControl)});
+  bulk->set_gating_sequences({&consumer.sequence(kBulk)});
+
+  std::vector<int64_t> latencies;
+  latencies.reserve(kControlEvents);
+  int64_t sum = 0;
+  std::thread runner([&]() {
+    consumer.Run([&](size_t ring, int64_t& event, int64_t, bool) {
+      if (ring == kControl)
+        latencies.push_back(NowNanos() - event);
+      else
+        sum += event;
+    });
+  });
+
+  std::atomic<bool> done(false);
+  std::thread bulk_publisher([&]() {
+    for (int64_t i = 0; !done.load(std::memory_order_relaxed); i++)
+      Publish(*bulk, i);
+  });
+
+  for (int64_t i = 0; i < kControlEvents; i++) {
+    const int64_t next = NowNanos() + kControlInterval;
+    while (NowNanos() < next) {
+    }
+    Publish(*control, NowNanos());
+  }
+  while (consumer.sequence(kControl).sequence() < kControlEvents - 1) {
+  }
+  done.store(true);
+  bulk_publisher.join();
+  consumer.set_alerted(true);
+  runner.join();
+
+  std::sort(latencies.begin(), latencies.end());
+  int64_t total = 0;
+  for (const int64_t latency : latencies) total += latency;
+  std::cout << name << " control latency mean: "
+            << total / static_cast<int64_t>(latencies.size())
+            << " ns, p99: " << latencies[latencies.size() * 99 / 100]
+            << " ns, max: " << latencies.back() << " ns" << std::endl;
+}
+
+int main(int arc, char** argv) {
+  Run("2P-1EP-ROUND-ROBIN", {1024, 1024}, FanInPriority::kRoundRobin);
+  Run("2P-1EP-WEIGHTED", {1024, 64}, FanInPriority::kRoundRobin);
+  Run("2P-1EP-STRICT", {1024, 64}, FanInPriority::kStrict);
+
+  return EXIT_SUCCESS;
+}
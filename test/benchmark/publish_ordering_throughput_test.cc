@@ -0,0 +1,119 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <sys/time.h>
+
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <disruptor/sequencer.h>
+
+using namespace disruptor;
+
+constexpr size_t kBufferSize = 1024 * 64;
+constexpr int64_t kIterations = 1000L * 1000L * 100;
+
+static double Now() {
+  struct timeval time;
+  gettimeofday(&time, NULL);
+  return time.tv_sec + ((double)time.tv_usec / 1000000);
+}
+
+// Cost of the claim and publish operations alone: the publisher is gated on
+// a consumer sequence kept ahead of it, nothing else touches the lines.
+template <typename C>
+double Run() {
+  using StubSequencer = Sequencer<int64_t, kBufferSize, C, BusySpinStrategy>;
+  std::unique_ptr<StubSequencer> sequencer(
+      new StubSequencer(std::array<int64_t, kBufferSize>()));
+  Sequence consumer_sequence(kIterations);
+  sequencer->set_gating_sequences({&consumer_sequence});
+
+  const double start = Now();
+  for (int64_t i = 0; i < kIterations; i++) {
+    const int64_t sequence = sequencer->Claim();
+    (*sequencer)[sequence] = i;
+    sequencer->Publish(sequence);
+  }
+  const double end = Now();
+
+  return kIterations / (end - start);
+}
+
+// One publisher to one consumer spinning on the cursor.
+template <typename C>
+double RunWithConsumer() {
+  using StubSequencer = Sequencer<int64_t, kBufferSize, C, BusySpinStrategy>;
+  std::unique_ptr<StubSequencer> sequencer(
+      new StubSequencer(std::array<int64_t, kBufferSize>()));
+  Sequence consumer_sequence;
+  sequencer->set_gating_sequences({&consumer_sequence});
+  auto barrier = sequencer->NewBarrier(std::vector<Sequence*>());
+
+  std::thread consumer([&]() {
+    int64_t sum = 0;
+    int64_t next_sequence = kFirstSequenceValue;
+    while (next_sequence < kIterations) {
+      const int64_t available = barrier->WaitFor(next_sequence);
+      for (; next_sequence <= available; next_sequence++)
+        sum += (*sequencer)[next_sequence];
+      consumer_sequence.set_sequence(available);
+    }
+  });
+
+  const double start = Now();
+  for (int64_t i = 0; i < kIterations; i++) {
+    const int64_t sequence = sequencer->Claim();
+    (*sequencer)[sequence] = i;
+    sequencer->Publish(sequence);
+  }
+  consumer.join();
+  const double end = Now();
+
+  return kIterations / (end - start);
+}
+
+int main(int arc, char** argv) {
+  std::cout.precision(15);
+  std::cout << "1P-SINGLE-THREADED-CLAIM-PUBLISH performance: ";
+  std::cout << Run<SingleThreadedStrategy<kBufferSize>>() << " ops/secs"
+            << std::endl;
+
+  std::cout << "1P-MULTI-THREADED-CLAIM-PUBLISH performance: ";
+  std::cout << Run<MultiThreadedStrategy<kBufferSize>>() << " ops/secs"
+            << std::endl;
+
+  std::cout << "1P-1EP-SINGLE-THREADED performance: ";
+  std::cout << RunWithConsumer<SingleThreadedStrategy<kBufferSize>>()
+            << " ops/secs" << std::endl;
+
+  std::cout << "1P-1EP-MULTI-THREADED performance: ";
+  std::cout << RunWithConsumer<MultiThreadedStrategy<kBufferSize>>()
+            << " ops/secs" << std::endl;
+
+  return EXIT_SUCCESS;
+}
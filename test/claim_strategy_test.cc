@@ -93,6 +93,26 @@ BOOST_AUTO_TEST_CASE(HasAvailableCapacity) {
                     sequence_1.IncrementAndGet(RING_BUFFER_SIZE));
 }
 
+BOOST_AUTO_TEST_CASE(RequestSequenceWhenGated) {
+  auto one_dependents = oneDependents();
+
+  strategy.IncrementAndGet(one_dependents, RING_BUFFER_SIZE);
+  BOOST_CHECK_EQUAL(strategy.requested_sequence().sequence(),
+                    kInitialCursorValue);
+
+  BOOST_CHECK_EQUAL(strategy.HasAvailableCapacity(one_dependents), false);
+  BOOST_CHECK_EQUAL(strategy.requested_sequence().sequence(), 0L);
+
+  // a blocked claim requests its own wrap point.
+  std::thread publisher([this, &one_dependents]() {
+    strategy.IncrementAndGet(one_dependents, 2L);
+  });
+  while (strategy.requested_sequence().sequence() < 1L)
+    std::this_thread::yield();
+  sequence_1.set_sequence(1L);
+  publisher.join();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 using MultiThreadedFixture =
@@ -246,6 +266,69 @@ BOOST_AUTO_TEST_CASE(SynchronizePublishingShouldBlockEagerThreads) {
   publisher_3.join();
 }
 
+BOOST_AUTO_TEST_CASE(RequestSequenceWhenGated) {
+  auto one_dependents = oneDependents();
+
+  strategy.IncrementAndGet(one_dependents, RING_BUFFER_SIZE);
+  BOOST_CHECK_EQUAL(strategy.requested_sequence().sequence(),
+                    kInitialCursorValue);
+
+  BOOST_CHECK_EQUAL(strategy.HasAvailableCapacity(one_dependents), false);
+  BOOST_CHECK_EQUAL(strategy.requested_sequence().sequence(), 0L);
+
+  // a blocked claim requests its own wrap point.
+  std::thread publisher([this, &one_dependents]() {
+    strategy.IncrementAndGet(one_dependents, 2L);
+  });
+  while (strategy.requested_sequence().sequence() < 1L)
+    std::this_thread::yield();
+  sequence_1.set_sequence(1L);
+  publisher.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+using LeasedFixture =
+    ClaimStrategyFixture<disruptor::MultiThreadedStrategy<RING_BUFFER_SIZE, 4>>;
+BOOST_FIXTURE_TEST_SUITE(LeasedMultiThreadedStrategy, LeasedFixture)
+
+BOOST_AUTO_TEST_CASE(ClaimFromLease) {
+  SequenceLease lease_1;
+  SequenceLease lease_2;
+
+  BOOST_CHECK_EQUAL(strategy.IncrementAndGet(empty_dependents, lease_1), 0L);
+  BOOST_CHECK_EQUAL(strategy.IncrementAndGet(empty_dependents, lease_2), 4L);
+  BOOST_CHECK_EQUAL(strategy.IncrementAndGet(empty_dependents, lease_1), 1L);
+  BOOST_CHECK_EQUAL(lease_1.remaining(), 2L);
+
+  strategy.IncrementAndGet(empty_dependents, lease_1);
+  strategy.IncrementAndGet(empty_dependents, lease_1);
+  // exhausted, the next lease starts after the second publisher's one.
+  BOOST_CHECK_EQUAL(strategy.IncrementAndGet(empty_dependents, lease_1), 8L);
+}
+
+BOOST_AUTO_TEST_CASE(PublishOutOfOrder) {
+  // leases [0, 3] and [4, 7], the second one is published first.
+  strategy.Publish(5L, cursor, 2);
+  strategy.Publish(4L, cursor, 1);
+  BOOST_CHECK_EQUAL(cursor.sequence(), kInitialCursorValue);
+
+  strategy.Publish(0L, cursor, 1);
+  BOOST_CHECK_EQUAL(cursor.sequence(), 0L);
+
+  strategy.Publish(3L, cursor, 3);
+  BOOST_CHECK_EQUAL(cursor.sequence(), 5L);
+
+  strategy.Publish(7L, cursor, 2);
+  BOOST_CHECK_EQUAL(cursor.sequence(), 7L);
+}
+
+BOOST_AUTO_TEST_CASE(PublishAfterWrap) {
+  for (int64_t sequence = 0; sequence < 3 * RING_BUFFER_SIZE; sequence++)
+    strategy.Publish(sequence, cursor, 1);
+  BOOST_CHECK_EQUAL(cursor.sequence(), 3 * RING_BUFFER_SIZE - 1L);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 };  // namespace test
@@ -0,0 +1,114 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ColumnRingBufferTest
+
+#define RING_BUFFER_SIZE 8
+
+#include <cstdint>
+
+#include <boost/test/unit_test.hpp>
+#include <disruptor/column_ring_buffer.h>
+#include <disruptor/sequencer.h>
+
+namespace disruptor {
+namespace test {
+
+using StubColumns = Columns<int64_t, double, char>;
+
+struct ColumnRingBufferFixture {
+  RingBuffer<StubColumns, RING_BUFFER_SIZE> ring_buffer;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ColumnRingBufferBasic, ColumnRingBufferFixture)
+
+BOOST_AUTO_TEST_CASE(ShouldStartWithValueInitialized) {
+  for (size_t i = 0; i < RING_BUFFER_SIZE; i++) {
+    BOOST_CHECK_EQUAL(ring_buffer[i].get<0>(), 0L);
+    BOOST_CHECK_EQUAL(ring_buffer[i].get<1>(), 0.0);
+    BOOST_CHECK_EQUAL(ring_buffer[i].get<2>(), '\0');
+  }
+}
+
+BOOST_AUTO_TEST_CASE(VerifyWrapArround) {
+  for (size_t i = 0; i < RING_BUFFER_SIZE; i++) {
+    auto slot = ring_buffer[i];
+    slot.get<0>() = i;
+    slot.get<1>() = i * 0.5;
+    slot.get<2>() = 'a' + i;
+  }
+
+  for (size_t i = 0; i < RING_BUFFER_SIZE * 2; i++) {
+    const auto& const_ring = ring_buffer;
+    BOOST_CHECK_EQUAL(const_ring[i].get<0>(), i % RING_BUFFER_SIZE);
+    BOOST_CHECK_EQUAL(const_ring[i].get<1>(), (i % RING_BUFFER_SIZE) * 0.5);
+    BOOST_CHECK_EQUAL(const_ring[i].get<2>(), 'a' + (i % RING_BUFFER_SIZE));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ColumnsAreContiguousAndAligned) {
+  for (size_t i = 0; i < RING_BUFFER_SIZE; i++) ring_buffer[i].get<1>() = i;
+
+  const auto& column = ring_buffer.column<1>();
+  for (size_t i = 0; i < RING_BUFFER_SIZE; i++) BOOST_CHECK_EQUAL(column[i], i);
+
+  const auto c0 = reinterpret_cast<uintptr_t>(&ring_buffer.column<0>());
+  const auto c1 = reinterpret_cast<uintptr_t>(&ring_buffer.column<1>());
+  const auto c2 = reinterpret_cast<uintptr_t>(&ring_buffer.column<2>());
+  BOOST_CHECK_EQUAL(c0 % kCacheLinePadding, 0);
+  BOOST_CHECK_EQUAL(c1 % kCacheLinePadding, 0);
+  BOOST_CHECK_EQUAL(c2 % kCacheLinePadding, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(ColumnSequencer)
+
+BOOST_AUTO_TEST_CASE(ClaimAndPublish) {
+  Sequencer<StubColumns, RING_BUFFER_SIZE,
+            SingleThreadedStrategy<RING_BUFFER_SIZE>, kDefaultWaitStrategy>
+      sequencer;
+
+  for (int64_t i = 0; i < RING_BUFFER_SIZE; i++) {
+    const int64_t sequence = sequencer.Claim();
+    BOOST_CHECK_EQUAL(sequence, i);
+    sequencer[sequence].get<0>() = i * 10;
+    sequencer[sequence].get<2>() = 'x';
+    sequencer.Publish(sequence);
+  }
+
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), RING_BUFFER_SIZE - 1);
+  for (int64_t i = 0; i < RING_BUFFER_SIZE; i++) {
+    BOOST_CHECK_EQUAL(sequencer[i].get<0>(), i * 10);
+    BOOST_CHECK_EQUAL(sequencer[i].get<1>(), 0.0);
+    BOOST_CHECK_EQUAL(sequencer[i].get<2>(), 'x');
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
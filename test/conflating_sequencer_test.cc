@@ -0,0 +1,145 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ConflatingSequencerTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+#include <disruptor/conflating_sequencer.h>
+
+#define RING_BUFFER_SIZE 8
+
+namespace disruptor {
+namespace test {
+
+using StubSequencer =
+    ConflatingSequencer<int, int64_t, RING_BUFFER_SIZE, kDefaultWaitStrategy>;
+
+struct ConflatingSequencerFixture {
+  ConflatingSequencerFixture() {
+    sequencer.set_gating_sequences({&consumer_sequence});
+  }
+
+  StubSequencer sequencer;
+  Sequence consumer_sequence;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ConflatingSequencerBasic, ConflatingSequencerFixture)
+
+BOOST_AUTO_TEST_CASE(ShouldConflatePendingUpdates) {
+  BOOST_CHECK(!sequencer.Publish(1, 10L));
+  BOOST_CHECK(!sequencer.Publish(2, 20L));
+  BOOST_CHECK(sequencer.Publish(1, 11L));
+  BOOST_CHECK(sequencer.Publish(1, 12L));
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), 1L);
+
+  const auto first = sequencer.Take(0);
+  BOOST_CHECK_EQUAL(first.first, 1);
+  BOOST_CHECK_EQUAL(first.second, 12L);
+  const auto second = sequencer.Take(1);
+  BOOST_CHECK_EQUAL(second.first, 2);
+  BOOST_CHECK_EQUAL(second.second, 20L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldPublishNewSequenceOnceTaken) {
+  BOOST_CHECK(!sequencer.Publish(1, 10L));
+  BOOST_CHECK_EQUAL(sequencer.Take(0).second, 10L);
+
+  BOOST_CHECK(!sequencer.Publish(1, 11L));
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), 1L);
+  BOOST_CHECK_EQUAL(sequencer.Take(1).second, 11L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldNotConflateIntoReusedSlot) {
+  BOOST_CHECK(!sequencer.Publish(0, 0L));
+  for (int64_t i = 0; i < RING_BUFFER_SIZE; i++) {
+    sequencer.Take(i);
+    consumer_sequence.set_sequence(i);
+    BOOST_CHECK(!sequencer.Publish(i + 1, i + 1));
+  }
+
+  // the slot of key 0 now holds key RING_BUFFER_SIZE.
+  BOOST_CHECK(!sequencer.Publish(0, 100L));
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), RING_BUFFER_SIZE + 1);
+  BOOST_CHECK_EQUAL(sequencer.Take(RING_BUFFER_SIZE).first, RING_BUFFER_SIZE);
+  BOOST_CHECK_EQUAL(sequencer.Take(RING_BUFFER_SIZE + 1).second, 100L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldForgetKeysLeavingTheRing) {
+  // every key takes a new slot, the index only holds the ring's keys.
+  const int kKeys = RING_BUFFER_SIZE * 16;
+  for (int key = 0; key < kKeys; key++) {
+    BOOST_CHECK(!sequencer.Publish(key, key));
+    BOOST_CHECK_EQUAL(sequencer.Take(key).first, key);
+    consumer_sequence.set_sequence(key);
+  }
+
+  BOOST_CHECK(!sequencer.Publish(kKeys, 0L));
+  BOOST_CHECK(sequencer.Publish(kKeys, 1L));
+  BOOST_CHECK(!sequencer.Publish(0, 2L));
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), kKeys + 1);
+  BOOST_CHECK_EQUAL(sequencer.Take(kKeys).second, 1L);
+  BOOST_CHECK_EQUAL(sequencer.Take(kKeys + 1).second, 2L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldDeliverLatestValueOfEveryKey) {
+  const int kKeys = 4;
+  const int64_t kUpdates = 200000;
+  const int kStop = -1;
+
+  std::vector<int64_t> latest(kKeys, -1L);
+  bool ordered = true;
+  auto barrier = sequencer.NewBarrier(std::vector<Sequence*>());
+  std::thread consumer([&]() {
+    int64_t next_sequence = kFirstSequenceValue;
+    while (true) {
+      const int64_t available = barrier->WaitFor(next_sequence);
+      for (; next_sequence <= available; next_sequence++) {
+        const auto update = sequencer.Take(next_sequence);
+        if (update.first == kStop) return;
+        ordered = ordered && update.second > latest[update.first];
+        latest[update.first] = update.second;
+      }
+      consumer_sequence.set_sequence(available);
+    }
+  });
+
+  for (int64_t i = 0; i < kUpdates; i++) sequencer.Publish(i % kKeys, i);
+  sequencer.Publish(kStop, 0L);
+  consumer.join();
+
+  BOOST_CHECK(ordered);
+  for (int key = 0; key < kKeys; key++)
+    BOOST_CHECK_EQUAL(latest[key], kUpdates - kKeys + key);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
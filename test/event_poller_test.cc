@@ -0,0 +1,185 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE EventPollerTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <disruptor/event_poller.h>
+#include <disruptor/sequencer.h>
+
+#define RING_BUFFER_SIZE 8
+
+namespace disruptor {
+namespace test {
+
+using StubSequencer =
+    Sequencer<int64_t, RING_BUFFER_SIZE,
+              SingleThreadedStrategy<RING_BUFFER_SIZE>, kDefaultWaitStrategy>;
+
+struct EventPollerFixture {
+  EventPollerFixture()
+      : sequencer(std::array<int64_t, RING_BUFFER_SIZE>()),
+        poller(sequencer, std::vector<Sequence*>()) {
+    sequencer.set_gating_sequences({&poller.sequence()});
+  }
+
+  void PublishEvents(int64_t count) {
+    for (int64_t i = 0; i < count; i++) {
+      const int64_t sequence = sequencer.Claim();
+      sequencer[sequence] = sequence * 10;
+      sequencer.Publish(sequence);
+    }
+  }
+
+  StubSequencer sequencer;
+  EventPoller<StubSequencer> poller;
+  std::vector<int64_t> handled;
+};
+
+BOOST_FIXTURE_TEST_SUITE(EventPollerBasic, EventPollerFixture)
+
+BOOST_AUTO_TEST_CASE(ShouldBeIdleWithoutEvents) {
+  const auto state = poller.Poll([](int64_t&, int64_t, bool) { return true; });
+  BOOST_CHECK(state == PollState::kIdle);
+  BOOST_CHECK_EQUAL(poller.sequence().sequence(), kInitialCursorValue);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldProcessEveryAvailableEvent) {
+  PublishEvents(3);
+
+  std::vector<bool> end_of_batch;
+  const auto state = poller.Poll([&](int64_t& event, int64_t, bool end) {
+    handled.push_back(event);
+    end_of_batch.push_back(end);
+    return true;
+  });
+
+  BOOST_CHECK(state == PollState::kProcessing);
+  BOOST_CHECK_EQUAL(poller.sequence().sequence(), 2L);
+  BOOST_REQUIRE_EQUAL(handled.size(), 3);
+  BOOST_CHECK_EQUAL(handled[2], 20L);
+  BOOST_CHECK(!end_of_batch[0] && !end_of_batch[1] && end_of_batch[2]);
+
+  BOOST_CHECK(poller.Poll([](int64_t&, int64_t, bool) { return true; }) ==
+              PollState::kIdle);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldStopWhenHandlerReturnsFalse) {
+  PublishEvents(4);
+
+  auto handler = [this](int64_t& event, int64_t sequence, bool) {
+    handled.push_back(event);
+    return sequence != 1L;
+  };
+
+  BOOST_CHECK(poller.Poll(handler) == PollState::kProcessing);
+  BOOST_CHECK_EQUAL(poller.sequence().sequence(), 1L);
+
+  BOOST_CHECK(poller.Poll(handler) == PollState::kProcessing);
+  BOOST_CHECK_EQUAL(poller.sequence().sequence(), 3L);
+  BOOST_CHECK_EQUAL(handled.size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldReportGatingOnDependents) {
+  Sequence upstream;
+  EventPoller<StubSequencer> downstream(sequencer, {&upstream});
+  PublishEvents(2);
+
+  auto handler = [](int64_t&, int64_t, bool) { return true; };
+  BOOST_CHECK(downstream.Poll(handler) == PollState::kGating);
+
+  upstream.set_sequence(0L);
+  BOOST_CHECK(downstream.Poll(handler) == PollState::kProcessing);
+  BOOST_CHECK_EQUAL(downstream.sequence().sequence(), 0L);
+  BOOST_CHECK(downstream.Poll(handler) == PollState::kGating);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldResumeStoppedBatchFromKnownEvents) {
+  Sequence upstream;
+  EventPoller<StubSequencer> downstream(sequencer, {&upstream});
+  PublishEvents(4);
+  upstream.set_sequence(3L);
+
+  auto handler = [this](int64_t& event, int64_t sequence, bool) {
+    handled.push_back(event);
+    return sequence != 1L;
+  };
+  BOOST_CHECK(downstream.Poll(handler) == PollState::kProcessing);
+  BOOST_CHECK_EQUAL(downstream.sequence().sequence(), 1L);
+
+  // the rest of the batch was seen available, upstream is not read again.
+  upstream.set_sequence(kInitialCursorValue);
+  BOOST_CHECK(downstream.Poll(handler) == PollState::kProcessing);
+  BOOST_CHECK_EQUAL(downstream.sequence().sequence(), 3L);
+  BOOST_CHECK_EQUAL(handled.size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldReleaseGatedPublisher) {
+  PublishEvents(RING_BUFFER_SIZE);
+  BOOST_CHECK(!sequencer.HasAvailableCapacity());
+
+  poller.Poll([](int64_t&, int64_t, bool) { return true; });
+  BOOST_CHECK(sequencer.HasAvailableCapacity());
+}
+
+BOOST_AUTO_TEST_CASE(ShouldDeferProgressUntilIdle) {
+  EventPoller<StubSequencer> deferred(sequencer, {}, 4,
+                                      ProgressPolicy::kDeferred);
+  sequencer.set_gating_sequences({&deferred.sequence()});
+  auto handler = [](int64_t&, int64_t, bool) { return true; };
+
+  PublishEvents(2);
+  BOOST_CHECK(deferred.Poll(handler) == PollState::kProcessing);
+  BOOST_CHECK_EQUAL(deferred.sequence().sequence(), kInitialCursorValue);
+
+  PublishEvents(3);
+  BOOST_CHECK(deferred.Poll(handler) == PollState::kProcessing);
+  BOOST_CHECK_EQUAL(deferred.sequence().sequence(), 3L);
+
+  // running out of events publishes the rest.
+  BOOST_CHECK(deferred.Poll(handler) == PollState::kIdle);
+  BOOST_CHECK_EQUAL(deferred.sequence().sequence(), 4L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldPublishDeferredProgressOnRequest) {
+  EventPoller<StubSequencer> deferred(sequencer, {}, kProgressAtEndOfBatch,
+                                      ProgressPolicy::kDeferred);
+  sequencer.set_gating_sequences({&deferred.sequence()});
+
+  PublishEvents(RING_BUFFER_SIZE);
+  BOOST_CHECK(!sequencer.HasAvailableCapacity());
+  BOOST_CHECK_EQUAL(sequencer.requested_sequence().sequence(), 0L);
+
+  deferred.Poll([](int64_t&, int64_t, bool) { return true; });
+  BOOST_CHECK_EQUAL(deferred.sequence().sequence(), 0L);
+  BOOST_CHECK(sequencer.HasAvailableCapacity());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
@@ -0,0 +1,200 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE EventFdWaitStrategyTest
+
+#include <sys/epoll.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <disruptor/eventfd_wait_strategy.h>
+#include <disruptor/sequencer.h>
+
+#define RING_BUFFER_SIZE 8
+
+namespace disruptor {
+namespace test {
+
+struct EventFdStrategyFixture {
+  EventFdStrategyFixture() : alerted(false) {}
+
+  // Number of pending wakeups on the eventfd, 0 if none.
+  uint64_t PendingWakeups() {
+    uint64_t value = 0;
+    if (::read(strategy.fd(), &value, sizeof(value)) < 0) return 0;
+    return value;
+  }
+
+  Sequence cursor;
+  Sequence sequence_1;
+  std::vector<Sequence*> dependents;
+  EventFdStrategy strategy;
+  std::atomic<bool> alerted;
+};
+
+BOOST_FIXTURE_TEST_SUITE(EventFdStrategy, EventFdStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(WaitForCursor) {
+  std::atomic<int64_t> return_value(kInitialCursorValue);
+
+  std::thread waiter([this, &return_value]() {
+    return_value.store(
+        strategy.WaitFor(kFirstSequenceValue, cursor, dependents, alerted));
+  });
+
+  BOOST_CHECK_EQUAL(return_value.load(), kInitialCursorValue);
+  std::thread([this]() {
+    cursor.IncrementAndGet(1L);
+    strategy.SignalAllWhenBlocking();
+  }).join();
+  waiter.join();
+  BOOST_CHECK_EQUAL(return_value.load(), kFirstSequenceValue);
+}
+
+BOOST_AUTO_TEST_CASE(SignalTimeoutWaitingOnCursor) {
+  BOOST_CHECK_EQUAL(strategy.WaitFor(kFirstSequenceValue, cursor, dependents,
+                                     alerted, std::chrono::milliseconds(1L)),
+                    kTimeoutSignal);
+
+  std::atomic<int64_t> return_value(kInitialCursorValue);
+  std::thread waiter([this, &return_value]() {
+    return_value.store(strategy.WaitFor(kFirstSequenceValue, cursor,
+                                        dependents, alerted,
+                                        std::chrono::seconds(1L)));
+  });
+
+  cursor.IncrementAndGet(1L);
+  strategy.SignalAllWhenBlocking();
+  waiter.join();
+  BOOST_CHECK_EQUAL(return_value.load(), kFirstSequenceValue);
+}
+
+BOOST_AUTO_TEST_CASE(RoundTimeoutUpToMilliseconds) {
+  const auto start = std::chrono::steady_clock::now();
+  BOOST_CHECK_EQUAL(strategy.WaitFor(kFirstSequenceValue, cursor, dependents,
+                                     alerted, std::chrono::microseconds(100L)),
+                    kTimeoutSignal);
+  BOOST_CHECK(std::chrono::steady_clock::now() - start >=
+              std::chrono::microseconds(100L));
+}
+
+BOOST_AUTO_TEST_CASE(SignalOnlyRegisteredSleepers) {
+  cursor.IncrementAndGet(1L);
+  strategy.SignalAllWhenBlocking();
+  BOOST_CHECK_EQUAL(PendingWakeups(), 0);
+
+  // already published, the consumer must not sleep.
+  BOOST_CHECK(!strategy.PrepareToSleep(kFirstSequenceValue, cursor));
+  strategy.SignalAllWhenBlocking();
+  BOOST_CHECK_EQUAL(PendingWakeups(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(CoalesceWakeups) {
+  BOOST_REQUIRE(strategy.PrepareToSleep(kFirstSequenceValue, cursor));
+  for (int i = 0; i < 100; i++) {
+    cursor.IncrementAndGet(1L);
+    strategy.SignalAllWhenBlocking();
+  }
+  BOOST_CHECK_EQUAL(PendingWakeups(), 1);
+  strategy.Acknowledge();
+
+  // re-armed for the next sleep.
+  BOOST_REQUIRE(strategy.PrepareToSleep(cursor.sequence() + 1L, cursor));
+  cursor.IncrementAndGet(1L);
+  strategy.SignalAllWhenBlocking();
+  strategy.SignalAllWhenBlocking();
+  BOOST_CHECK_EQUAL(PendingWakeups(), 1);
+  strategy.Acknowledge();
+}
+
+BOOST_AUTO_TEST_CASE(WakeUpEpollLoop) {
+  const int epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+  BOOST_REQUIRE(epoll_fd >= 0);
+  struct epoll_event event = {};
+  event.events = EPOLLIN;
+  BOOST_REQUIRE(::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, strategy.fd(), &event) ==
+                0);
+
+  BOOST_REQUIRE(strategy.PrepareToSleep(kFirstSequenceValue, cursor));
+  std::thread publisher([this]() {
+    cursor.IncrementAndGet(1L);
+    strategy.SignalAllWhenBlocking();
+  });
+
+  struct epoll_event ready;
+  BOOST_CHECK_EQUAL(::epoll_wait(epoll_fd, &ready, 1, 5000), 1);
+  strategy.Acknowledge();
+  publisher.join();
+  BOOST_CHECK_EQUAL(cursor.sequence(), kFirstSequenceValue);
+
+  BOOST_CHECK_EQUAL(::epoll_wait(epoll_fd, &ready, 1, 0), 0);
+  ::close(epoll_fd);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(EventFdSequencer)
+
+BOOST_AUTO_TEST_CASE(BarrierSharesSequencerStrategy) {
+  Sequencer<int64_t, RING_BUFFER_SIZE, SingleThreadedStrategy<RING_BUFFER_SIZE>,
+            disruptor::EventFdStrategy>
+      sequencer(std::array<int64_t, RING_BUFFER_SIZE>{});
+  auto barrier = sequencer.NewBarrier(std::vector<Sequence*>());
+
+  std::atomic<int64_t> return_value(kInitialCursorValue);
+  std::thread waiter([&barrier, &return_value]() {
+    return_value.store(barrier->WaitFor(kFirstSequenceValue));
+  });
+
+  const int64_t sequence = sequencer.Claim();
+  sequencer[sequence] = 42;
+  sequencer.Publish(sequence);
+  waiter.join();
+  BOOST_CHECK_EQUAL(return_value.load(), kFirstSequenceValue);
+}
+
+BOOST_AUTO_TEST_CASE(AlertWakesUpBlockedConsumer) {
+  Sequencer<int64_t, RING_BUFFER_SIZE, SingleThreadedStrategy<RING_BUFFER_SIZE>,
+            disruptor::EventFdStrategy>
+      sequencer(std::array<int64_t, RING_BUFFER_SIZE>{});
+  auto barrier = sequencer.NewBarrier(std::vector<Sequence*>());
+
+  std::atomic<int64_t> return_value(kInitialCursorValue);
+  std::thread waiter([&barrier, &return_value]() {
+    return_value.store(barrier->WaitFor(kFirstSequenceValue));
+  });
+
+  // give the consumer time to block in poll().
+  std::this_thread::sleep_for(std::chrono::milliseconds(10L));
+  barrier->set_alerted(true);
+  waiter.join();
+  BOOST_CHECK_EQUAL(return_value.load(), kAlertedSignal);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
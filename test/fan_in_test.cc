@@ -0,0 +1,222 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE FanInTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <disruptor/fan_in.h>
+#include <disruptor/sequencer.h>
+
+#define RING_BUFFER_SIZE 8
+#define RINGS 3
+
+namespace disruptor {
+namespace test {
+
+using StubSequencer =
+    Sequencer<int64_t, RING_BUFFER_SIZE,
+              SingleThreadedStrategy<RING_BUFFER_SIZE>, kDefaultWaitStrategy>;
+
+struct FanInFixture {
+  FanInFixture()
+      : sequencer_0(std::array<int64_t, RING_BUFFER_SIZE>()),
+        sequencer_1(std::array<int64_t, RING_BUFFER_SIZE>()),
+        sequencer_2(std::array<int64_t, RING_BUFFER_SIZE>()),
+        consumer({&sequencer_0, &sequencer_1, &sequencer_2}, 4) {
+    sequencer_0.set_gating_sequences({&consumer.sequence(0)});
+    sequencer_1.set_gating_sequences({&consumer.sequence(1)});
+    sequencer_2.set_gating_sequences({&consumer.sequence(2)});
+  }
+
+  void PublishEvents(StubSequencer& sequencer, int64_t count, int64_t value) {
+    for (int64_t i = 0; i < count; i++) {
+      const int64_t sequence = sequencer.Claim();
+      sequencer[sequence] = value;
+      sequencer.Publish(sequence);
+    }
+  }
+
+  void Record(size_t ring, int64_t& event, int64_t sequence, bool) {
+    rings.push_back(ring);
+    events.push_back(event);
+  }
+
+  StubSequencer sequencer_0;
+  StubSequencer sequencer_1;
+  StubSequencer sequencer_2;
+  FanInConsumer<StubSequencer> consumer;
+  std::vector<size_t> rings;
+  std::vector<int64_t> events;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FanInBasic, FanInFixture)
+
+BOOST_AUTO_TEST_CASE(ShouldBeIdleWithoutEvents) {
+  const auto handler = [this](size_t ring, int64_t& event, int64_t sequence,
+                              bool end) { Record(ring, event, sequence, end); };
+  BOOST_CHECK_EQUAL(consumer.size(), RINGS);
+  BOOST_CHECK_EQUAL(consumer.Drain(handler), 0);
+  BOOST_CHECK(events.empty());
+}
+
+BOOST_AUTO_TEST_CASE(ShouldDrainEveryRingWithData) {
+  PublishEvents(sequencer_0, 2, 10);
+  PublishEvents(sequencer_2, 1, 30);
+
+  const auto handler = [this](size_t ring, int64_t& event, int64_t sequence,
+                              bool end) { Record(ring, event, sequence, end); };
+  BOOST_CHECK_EQUAL(consumer.Drain(handler), 3);
+  BOOST_CHECK_EQUAL(consumer.sequence(0).sequence(), 1L);
+  BOOST_CHECK_EQUAL(consumer.sequence(1).sequence(), kInitialCursorValue);
+  BOOST_CHECK_EQUAL(consumer.sequence(2).sequence(), 0L);
+
+  std::vector<size_t> expected_rings = {0, 0, 2};
+  std::vector<int64_t> expected_events = {10, 10, 30};
+  BOOST_CHECK_EQUAL_COLLECTIONS(rings.begin(), rings.end(),
+                                expected_rings.begin(), expected_rings.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(events.begin(), events.end(),
+                                expected_events.begin(),
+                                expected_events.end());
+}
+
+BOOST_AUTO_TEST_CASE(ShouldBoundBatchPerRing) {
+  PublishEvents(sequencer_0, RING_BUFFER_SIZE, 10);
+  PublishEvents(sequencer_1, 1, 20);
+
+  std::vector<bool> end_of_batch;
+  const auto handler = [&](size_t ring, int64_t& event, int64_t sequence,
+                           bool end) {
+    Record(ring, event, sequence, end);
+    end_of_batch.push_back(end);
+  };
+  BOOST_CHECK_EQUAL(consumer.Drain(handler), 5);
+  BOOST_CHECK_EQUAL(consumer.sequence(0).sequence(), 3L);
+  BOOST_CHECK(end_of_batch[3]);
+
+  BOOST_CHECK_EQUAL(consumer.Drain(handler), 4);
+  BOOST_CHECK_EQUAL(consumer.sequence(0).sequence(), RING_BUFFER_SIZE - 1);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldDrainHigherPriorityRingsFirst) {
+  FanInConsumer<StubSequencer> strict(
+      {&sequencer_0, &sequencer_1, &sequencer_2}, {2, 2, 2},
+      FanInPriority::kStrict);
+  sequencer_0.set_gating_sequences({&strict.sequence(0)});
+  sequencer_1.set_gating_sequences({&strict.sequence(1)});
+  sequencer_2.set_gating_sequences({&strict.sequence(2)});
+
+  PublishEvents(sequencer_2, 3, 30);
+  PublishEvents(sequencer_1, 1, 20);
+  PublishEvents(sequencer_0, 2, 10);
+
+  const auto handler = [this](size_t ring, int64_t& event, int64_t sequence,
+                              bool end) { Record(ring, event, sequence, end); };
+  BOOST_CHECK_EQUAL(strict.Drain(handler), 2);
+  BOOST_CHECK_EQUAL(strict.Drain(handler), 1);
+  BOOST_CHECK_EQUAL(strict.Drain(handler), 2);
+
+  // a new event of the first ring overtakes the rest of the last one.
+  PublishEvents(sequencer_0, 1, 11);
+  BOOST_CHECK_EQUAL(strict.Drain(handler), 1);
+  BOOST_CHECK_EQUAL(strict.Drain(handler), 1);
+  BOOST_CHECK_EQUAL(strict.Drain(handler), 0);
+  BOOST_CHECK_EQUAL(strict.sequence(0).sequence(), 2L);
+  BOOST_CHECK_EQUAL(strict.sequence(1).sequence(), 0L);
+  BOOST_CHECK_EQUAL(strict.sequence(2).sequence(), 2L);
+
+  std::vector<size_t> expected_rings = {0, 0, 1, 2, 2, 0, 2};
+  std::vector<int64_t> expected_events = {10, 10, 20, 30, 30, 11, 30};
+  BOOST_CHECK_EQUAL_COLLECTIONS(rings.begin(), rings.end(),
+                                expected_rings.begin(), expected_rings.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(events.begin(), events.end(),
+                                expected_events.begin(),
+                                expected_events.end());
+}
+
+BOOST_AUTO_TEST_CASE(ShouldWeightRingsByBatchSize) {
+  FanInConsumer<StubSequencer> weighted(
+      {&sequencer_0, &sequencer_1, &sequencer_2}, {1, 3, 2});
+  sequencer_0.set_gating_sequences({&weighted.sequence(0)});
+  sequencer_1.set_gating_sequences({&weighted.sequence(1)});
+  sequencer_2.set_gating_sequences({&weighted.sequence(2)});
+
+  PublishEvents(sequencer_0, 6, 10);
+  PublishEvents(sequencer_1, 6, 20);
+  PublishEvents(sequencer_2, 6, 30);
+
+  const auto handler = [this](size_t ring, int64_t& event, int64_t sequence,
+                              bool end) { Record(ring, event, sequence, end); };
+  BOOST_CHECK_EQUAL(weighted.Drain(handler), 6);
+  BOOST_CHECK_EQUAL(weighted.sequence(0).sequence(), 0L);
+  BOOST_CHECK_EQUAL(weighted.sequence(1).sequence(), 2L);
+  BOOST_CHECK_EQUAL(weighted.sequence(2).sequence(), 1L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldRequireOneBatchSizePerRing) {
+  BOOST_CHECK_THROW(FanInConsumer<StubSequencer>(
+                        {&sequencer_0, &sequencer_1}, std::vector<int64_t>{1}),
+                    std::invalid_argument);
+  // a ring visited for no event would never be drained.
+  BOOST_CHECK_THROW(
+      FanInConsumer<StubSequencer>({&sequencer_0, &sequencer_1},
+                                   std::vector<int64_t>{1, 0}),
+      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldRunUntilAlerted) {
+  const int64_t iterations = RING_BUFFER_SIZE * 16;
+  std::atomic<int64_t> sum(0);
+
+  std::thread runner([this, &sum]() {
+    consumer.Run([&sum](size_t ring, int64_t& event, int64_t, bool) {
+      sum += event;
+    });
+  });
+
+  std::thread publisher_0(
+      [this, iterations]() { PublishEvents(sequencer_0, iterations, 1); });
+  std::thread publisher_1(
+      [this, iterations]() { PublishEvents(sequencer_1, iterations, 2); });
+  std::thread publisher_2(
+      [this, iterations]() { PublishEvents(sequencer_2, iterations, 3); });
+  publisher_0.join();
+  publisher_1.join();
+  publisher_2.join();
+
+  while (consumer.sequence(0).sequence() < iterations - 1 ||
+         consumer.sequence(1).sequence() < iterations - 1 ||
+         consumer.sequence(2).sequence() < iterations - 1)
+    ;
+  consumer.set_alerted(true);
+  runner.join();
+  BOOST_CHECK_EQUAL(sum.load(), iterations * 6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
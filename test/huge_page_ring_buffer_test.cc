@@ -0,0 +1,115 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE HugePageRingBufferTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+
+#include <disruptor/huge_page_ring_buffer.h>
+#include <disruptor/sequencer.h>
+
+#define RING_BUFFER_SIZE 1024
+
+namespace disruptor {
+namespace test {
+
+struct StubEvent {
+  StubEvent() : value(-1L) {}
+
+  int64_t value;
+  char payload[120];
+};
+
+constexpr int kThrowAt = 100;
+
+// Throws when the kThrowAt-th event is built, counting live events.
+struct ThrowingEvent {
+  ThrowingEvent() {
+    if (constructed == kThrowAt) throw std::runtime_error("ThrowingEvent");
+    constructed++;
+    alive++;
+  }
+
+  ~ThrowingEvent() { alive--; }
+
+  static int constructed;
+  static int alive;
+};
+
+int ThrowingEvent::constructed = 0;
+int ThrowingEvent::alive = 0;
+
+BOOST_AUTO_TEST_SUITE(HugePageRingBufferBasic)
+
+BOOST_AUTO_TEST_CASE(ShouldMapConstructedEvents) {
+  RingBuffer<HugePages<StubEvent>, RING_BUFFER_SIZE> ring_buffer;
+
+  BOOST_CHECK(ring_buffer.length() >= sizeof(StubEvent) * RING_BUFFER_SIZE);
+  BOOST_CHECK_EQUAL(ring_buffer.length() % kHugePageSize, 0);
+  for (int64_t i = 0; i < RING_BUFFER_SIZE; i++)
+    BOOST_CHECK_EQUAL(ring_buffer[i].value, -1L);
+
+  // huge pages, reserved or transparent, need an aligned mapping.
+  if (ring_buffer.backing() != PageBacking::kRegularPages)
+    BOOST_CHECK_EQUAL(
+        reinterpret_cast<uintptr_t>(&ring_buffer[0]) % kHugePageSize, 0);
+}
+
+BOOST_AUTO_TEST_CASE(VerifyWrapArround) {
+  RingBuffer<HugePages<StubEvent>, RING_BUFFER_SIZE> ring_buffer;
+
+  for (int64_t i = 0; i < RING_BUFFER_SIZE; i++) ring_buffer[i].value = i;
+  for (int64_t i = 0; i < RING_BUFFER_SIZE * 2; i++)
+    BOOST_CHECK_EQUAL(ring_buffer[i].value, i % RING_BUFFER_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldBackSequencer) {
+  Sequencer<HugePages<StubEvent>, RING_BUFFER_SIZE,
+            SingleThreadedStrategy<RING_BUFFER_SIZE>, kDefaultWaitStrategy>
+      sequencer;
+
+  const int64_t sequence = sequencer.Claim();
+  sequencer[sequence].value = 42L;
+  sequencer.Publish(sequence);
+
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), sequence);
+  BOOST_CHECK_EQUAL(sequencer.ring_buffer()[sequence].value, 42L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldDestroyBuiltEventsWhenConstructionThrows) {
+  using ThrowingRingBuffer = RingBuffer<HugePages<ThrowingEvent>,
+                                        RING_BUFFER_SIZE>;
+  BOOST_CHECK_THROW(ThrowingRingBuffer ring_buffer, std::runtime_error);
+  BOOST_CHECK_EQUAL(ThrowingEvent::constructed, kThrowAt);
+  BOOST_CHECK_EQUAL(ThrowingEvent::alive, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
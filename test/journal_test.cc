@@ -0,0 +1,186 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JournalTest
+
+#include <stdlib.h>
+
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+
+#include <disruptor/journal.h>
+#include <disruptor/sequencer.h>
+
+#define RING_BUFFER_SIZE 8
+#define SEGMENT_EVENTS 5
+
+namespace disruptor {
+namespace test {
+
+struct StubEvent {
+  int64_t value;
+  double price;
+};
+
+using StubSequencer =
+    Sequencer<StubEvent, RING_BUFFER_SIZE,
+              SingleThreadedStrategy<RING_BUFFER_SIZE>, kDefaultWaitStrategy>;
+
+struct JournalFixture {
+  JournalFixture() : sequencer(std::array<StubEvent, RING_BUFFER_SIZE>()) {
+    char directory[] = "/tmp/disruptor_journal_XXXXXX";
+    BOOST_REQUIRE(::mkdtemp(directory) != nullptr);
+    root = directory;
+    path = root + "/events";
+  }
+
+  ~JournalFixture() {
+    for (size_t i = 0; JournalSegmentExists(path, i); i++)
+      ::unlink(JournalSegmentPath(path, i).c_str());
+    ::rmdir(root.c_str());
+  }
+
+  // Replay the journal into a fresh ring, checking events are in order.
+  int64_t ReplayAndVerify(int64_t expected) {
+    StubSequencer replayed(std::array<StubEvent, RING_BUFFER_SIZE>{});
+    Sequence consumer;
+    replayed.set_gating_sequences({&consumer});
+
+    std::thread reader([this, &replayed, &consumer, expected]() {
+      for (int64_t i = 0; i < expected; i++) {
+        while (replayed.GetCursor() < i)
+          ;
+        BOOST_CHECK_EQUAL(replayed[i].value, i);
+        BOOST_CHECK_EQUAL(replayed[i].price, i * 0.25);
+        consumer.set_sequence(i);
+      }
+    });
+
+    JournalReader<StubEvent> journal_reader(path);
+    const int64_t count = journal_reader.Replay(replayed, 3);
+    reader.join();
+    return count;
+  }
+
+  std::string root;
+  std::string path;
+  StubSequencer sequencer;
+};
+
+BOOST_FIXTURE_TEST_SUITE(JournalBasic, JournalFixture)
+
+BOOST_AUTO_TEST_CASE(AppendAndReplayAcrossSegments) {
+  {
+    Journal<StubEvent> journal(path, SEGMENT_EVENTS, SyncPolicy::kPerBatch);
+    StubEvent events[12];
+    for (int64_t i = 0; i < 12; i++) events[i] = {i, i * 0.25};
+    journal.Append(events, 12);
+  }
+
+  BOOST_CHECK(JournalSegmentExists(path, 0));
+  BOOST_CHECK(JournalSegmentExists(path, 1));
+  BOOST_CHECK(JournalSegmentExists(path, 2));
+  BOOST_CHECK(!JournalSegmentExists(path, 3));
+  BOOST_CHECK_EQUAL(ReplayAndVerify(12), 12);
+}
+
+BOOST_AUTO_TEST_CASE(ResumeAppendingAfterReopen) {
+  for (int64_t i = 0; i < 7; i++) {
+    Journal<StubEvent> journal(path, SEGMENT_EVENTS);
+    const StubEvent event = {i, i * 0.25};
+    journal.Append(&event, 1);
+  }
+
+  BOOST_CHECK_EQUAL(ReplayAndVerify(7), 7);
+}
+
+BOOST_AUTO_TEST_CASE(ConsumePublishedRanges) {
+  Sequence consumer;
+  sequencer.set_gating_sequences({&consumer});
+  std::vector<Sequence*> dependents;
+  SequenceBarrier<> barrier(sequencer.cursor(), dependents);
+
+  Journal<StubEvent> journal(path, SEGMENT_EVENTS, SyncPolicy::kInterval,
+                             std::chrono::milliseconds(1));
+  std::thread journaler([this, &journal, &barrier, &consumer]() {
+    journal.Consume(sequencer, barrier, consumer);
+  });
+
+  for (int64_t i = 0; i < 20; i++) {
+    const int64_t sequence = sequencer.Claim();
+    sequencer[sequence] = {i, i * 0.25};
+    sequencer.Publish(sequence);
+  }
+
+  while (consumer.sequence() < 19)
+    ;
+  barrier.set_alerted(true);
+  journaler.join();
+
+  BOOST_CHECK_EQUAL(ReplayAndVerify(20), 20);
+}
+
+BOOST_AUTO_TEST_CASE(RejectMismatchedEventSize) {
+  {
+    Journal<StubEvent> journal(path, SEGMENT_EVENTS);
+    const StubEvent event = {1, 1.0};
+    journal.Append(&event, 1);
+  }
+
+  BOOST_CHECK_THROW(Journal<int64_t> journal(path, SEGMENT_EVENTS),
+                    std::system_error);
+}
+
+BOOST_AUTO_TEST_CASE(CommitEventsOnceSynced) {
+  Journal<StubEvent> journal(path, SEGMENT_EVENTS, SyncPolicy::kInterval,
+                             std::chrono::hours(1));
+  const StubEvent events[] = {{0, 0.0}, {1, 0.25}};
+  journal.Append(events, 2);
+
+  JournalSegment segment(JournalSegmentPath(path, 0), sizeof(StubEvent), 0,
+                         false);
+  BOOST_CHECK_EQUAL(segment.header()->count.load(), 0);
+  journal.Sync();
+  BOOST_CHECK_EQUAL(segment.header()->count.load(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(RejectInvalidSizes) {
+  BOOST_CHECK_THROW(Journal<StubEvent> journal(path, 0), std::invalid_argument);
+
+  JournalReader<StubEvent> journal_reader(path);
+  BOOST_CHECK_THROW(journal_reader.Replay(sequencer, 0), std::invalid_argument);
+  BOOST_CHECK_THROW(journal_reader.Replay(sequencer, RING_BUFFER_SIZE + 1),
+                    std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
@@ -0,0 +1,137 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE PayloadPoolTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <set>
+#include <thread>
+
+#include <disruptor/payload_pool.h>
+
+#define RING_BUFFER_SIZE 8
+
+namespace disruptor {
+namespace test {
+
+struct PayloadPoolFixture {
+  PayloadPoolFixture() : pool({{4096, 2}, {65536, 1}}) {}
+
+  PayloadPool<RING_BUFFER_SIZE> pool;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PayloadPoolBasic, PayloadPoolFixture)
+
+BOOST_AUTO_TEST_CASE(ShouldAllocateFromSmallestFittingClass) {
+  const Payload small = pool.Allocate(100);
+  BOOST_CHECK(!small.empty());
+  BOOST_CHECK_EQUAL(small.size_class, 0);
+
+  const Payload large = pool.Allocate(4097);
+  BOOST_CHECK(!large.empty());
+  BOOST_CHECK_EQUAL(large.size_class, 1);
+
+  std::memset(small.data, 'a', 4096);
+  std::memset(large.data, 'b', 65536);
+  BOOST_CHECK_EQUAL(static_cast<char*>(small.data)[4095], 'a');
+
+  BOOST_CHECK(pool.Allocate(65537).empty());
+}
+
+BOOST_AUTO_TEST_CASE(ShouldFallBackToLargerClassWhenExhausted) {
+  const Payload first = pool.Allocate(4096);
+  const Payload second = pool.Allocate(4096);
+  const Payload third = pool.Allocate(4096);
+  BOOST_CHECK_EQUAL(first.size_class, 0);
+  BOOST_CHECK_EQUAL(second.size_class, 0);
+  BOOST_CHECK(first.data != second.data);
+  BOOST_CHECK_EQUAL(third.size_class, 1);
+  BOOST_CHECK(pool.Allocate(1).empty());
+
+  pool.Release(second);
+  const Payload reused = pool.Allocate(1);
+  BOOST_CHECK_EQUAL(reused.data, second.data);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldReclaimAttachedPayloadsBySequence) {
+  pool.Attach(0, pool.Allocate(1));
+  pool.Attach(2, pool.Allocate(1));
+  BOOST_CHECK(pool.Allocate(1).size_class == 1);
+  BOOST_CHECK(pool.Allocate(1).empty());
+
+  // sequence 1 carries no payload.
+  pool.Reclaim(1);
+  BOOST_CHECK(!pool.Allocate(1).empty());
+  BOOST_CHECK(pool.Allocate(1).empty());
+
+  pool.Reclaim(2);
+  BOOST_CHECK(!pool.Allocate(1).empty());
+
+  // reclaimed slots do not release their payload twice.
+  pool.Reclaim(2 + RING_BUFFER_SIZE);
+  BOOST_CHECK(pool.Allocate(1).empty());
+}
+
+BOOST_AUTO_TEST_CASE(ShouldRejectInvalidSizeClasses) {
+  using Pool = PayloadPool<RING_BUFFER_SIZE>;
+  BOOST_CHECK_THROW(Pool({{4096, 1}, {4096, 1}}), std::invalid_argument);
+  BOOST_CHECK_THROW(Pool({{4096, 0}}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldNeverHandOutABlockTwice) {
+  PayloadPool<RING_BUFFER_SIZE> shared({{64, 16}});
+  const int kIterations = 20000;
+
+  std::vector<std::thread> threads;
+  std::atomic<int> conflicts(0);
+  for (int t = 0; t < 4; t++)
+    threads.emplace_back([&shared, &conflicts, t]() {
+      for (int i = 0; i < kIterations; i++) {
+        const Payload payload = shared.Allocate(64);
+        if (payload.empty()) continue;
+        volatile int* owner = static_cast<volatile int*>(payload.data);
+        *owner = t;
+        std::this_thread::yield();
+        if (*owner != t) conflicts++;
+        shared.Release(payload);
+      }
+    });
+  for (auto& thread : threads) thread.join();
+
+  BOOST_CHECK_EQUAL(conflicts.load(), 0);
+  std::set<void*> blocks;
+  for (int i = 0; i < 16; i++) blocks.insert(shared.Allocate(64).data);
+  BOOST_CHECK_EQUAL(blocks.size(), 16);
+  BOOST_CHECK(blocks.count(nullptr) == 0);
+  BOOST_CHECK(shared.Allocate(64).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
@@ -0,0 +1,214 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE PipelineTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+
+#include <disruptor/pipeline.h>
+#include <disruptor/sequencer.h>
+
+#define RING_BUFFER_SIZE 8
+
+namespace disruptor {
+namespace test {
+
+struct StubEvent {
+  int64_t value;
+  int64_t stages;
+};
+
+using StubSequencer =
+    Sequencer<StubEvent, RING_BUFFER_SIZE,
+              SingleThreadedStrategy<RING_BUFFER_SIZE>, kDefaultWaitStrategy>;
+
+// Marks every event it sees after checking its upstream stages did.
+template <int64_t Mark, int64_t Upstream>
+struct MarkingHandler {
+  MarkingHandler() : events(0), batches(0), ordered(true) {}
+
+  void operator()(StubEvent& event, int64_t sequence, bool end_of_batch) {
+    ordered = ordered && (event.stages & Upstream) == Upstream;
+    event.stages |= Mark;
+    events++;
+    if (end_of_batch) batches++;
+  }
+
+  int64_t events;
+  int64_t batches;
+  bool ordered;
+};
+
+using Journaler = MarkingHandler<1, 0>;
+using Replicator = MarkingHandler<2, 0>;
+using Unmarshaller = MarkingHandler<4, 1>;
+using BusinessLogic = MarkingHandler<8, 7>;
+
+// Diamond: 0 and 1 behind the cursor, 2 behind 0, 3 behind 1 and 2.
+using StubPipeline =
+    Pipeline<StubSequencer, BusySpinStrategy, Stage<Journaler>,
+             Stage<Replicator>, Stage<Unmarshaller, 0>,
+             Stage<BusinessLogic, 1, 2>>;
+
+static_assert(StubPipeline::kStages == 4, "four stages");
+static_assert(!StubPipeline::IsGating(0), "stage 2 depends on stage 0");
+static_assert(!StubPipeline::IsGating(1), "stage 3 depends on stage 1");
+static_assert(!StubPipeline::IsGating(2), "stage 3 depends on stage 2");
+static_assert(StubPipeline::IsGating(3), "stage 3 is a leaf");
+
+struct PipelineFixture {
+  PipelineFixture()
+      : sequencer(std::array<StubEvent, RING_BUFFER_SIZE>()),
+        pipeline(sequencer, journaler, replicator, unmarshaller,
+                 business_logic) {}
+
+  void PublishEvents(int64_t count) {
+    for (int64_t i = 0; i < count; i++) {
+      const int64_t sequence = sequencer.Claim();
+      sequencer[sequence].value = sequence;
+      sequencer[sequence].stages = 0;
+      sequencer.Publish(sequence);
+    }
+  }
+
+  StubSequencer sequencer;
+  Journaler journaler;
+  Replicator replicator;
+  Unmarshaller unmarshaller;
+  BusinessLogic business_logic;
+  StubPipeline pipeline;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PipelineBasic, PipelineFixture)
+
+BOOST_AUTO_TEST_CASE(ShouldGateOnLeafStagesOnly) {
+  PublishEvents(RING_BUFFER_SIZE);
+  BOOST_CHECK(sequencer.HasAvailableCapacity() == false);
+
+  // halted stages return once they drained their available events.
+  pipeline.Halt();
+  pipeline.Run<0>();
+  pipeline.Run<1>();
+  pipeline.Run<2>();
+  BOOST_CHECK(sequencer.HasAvailableCapacity() == false);
+
+  pipeline.Run<3>();
+  BOOST_CHECK(sequencer.HasAvailableCapacity() == true);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldNotRunAheadOfDependencies) {
+  PublishEvents(4);
+
+  pipeline.Halt();
+  pipeline.Run<3>();
+  BOOST_CHECK_EQUAL(business_logic.events, 0);
+  pipeline.Run<1>();
+  pipeline.Run<2>();
+  BOOST_CHECK_EQUAL(unmarshaller.events, 0);
+
+  pipeline.Run<0>();
+  pipeline.Run<2>();
+  pipeline.Run<3>();
+  BOOST_CHECK_EQUAL(journaler.events, 4);
+  BOOST_CHECK_EQUAL(replicator.events, 4);
+  BOOST_CHECK_EQUAL(unmarshaller.events, 4);
+  BOOST_CHECK_EQUAL(business_logic.events, 4);
+  BOOST_CHECK_EQUAL(business_logic.batches, 1);
+  BOOST_CHECK_EQUAL(pipeline.sequence<3>().sequence(), 3L);
+  BOOST_CHECK(unmarshaller.ordered && business_logic.ordered);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldProcessEventsWithThreads) {
+  const int64_t kEvents = RING_BUFFER_SIZE * 64;
+
+  pipeline.Start();
+  PublishEvents(kEvents);
+  while (pipeline.sequence<3>().sequence() < kEvents - 1)
+    std::this_thread::yield();
+  pipeline.Halt();
+
+  BOOST_CHECK_EQUAL(journaler.events, kEvents);
+  BOOST_CHECK_EQUAL(replicator.events, kEvents);
+  BOOST_CHECK_EQUAL(unmarshaller.events, kEvents);
+  BOOST_CHECK_EQUAL(business_logic.events, kEvents);
+  BOOST_CHECK(unmarshaller.ordered && business_logic.ordered);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldDrainEveryStageWhenHalted) {
+  const int64_t kEvents = RING_BUFFER_SIZE * 64;
+
+  pipeline.Start();
+  PublishEvents(kEvents);
+  pipeline.Halt();
+
+  BOOST_CHECK_EQUAL(journaler.events, kEvents);
+  BOOST_CHECK_EQUAL(replicator.events, kEvents);
+  BOOST_CHECK_EQUAL(unmarshaller.events, kEvents);
+  BOOST_CHECK_EQUAL(business_logic.events, kEvents);
+  BOOST_CHECK_EQUAL(pipeline.sequence<3>().sequence(), kEvents - 1);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldRejectStartingTwice) {
+  pipeline.Start();
+  BOOST_CHECK_THROW(pipeline.Start(), std::logic_error);
+  pipeline.Halt();
+
+  // halted stages may start again.
+  pipeline.Start();
+  PublishEvents(4);
+  pipeline.Halt();
+  BOOST_CHECK_EQUAL(business_logic.events, 4);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldStartCleanAfterWarmUp) {
+  const int64_t kCycles = RING_BUFFER_SIZE * 16;
+  pipeline.WarmUp(kCycles, [](StubEvent& event) {
+    event.value = -1L;
+    event.stages = 0;
+  });
+
+  BOOST_CHECK_EQUAL(business_logic.events, kCycles);
+  BOOST_CHECK(business_logic.ordered);
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), kInitialCursorValue);
+  BOOST_CHECK_EQUAL(pipeline.sequence<0>().sequence(), kInitialCursorValue);
+  BOOST_CHECK_EQUAL(pipeline.sequence<3>().sequence(), kInitialCursorValue);
+
+  PublishEvents(4);
+  pipeline.Halt();
+  pipeline.Run<0>();
+  pipeline.Run<1>();
+  pipeline.Run<2>();
+  pipeline.Run<3>();
+  BOOST_CHECK_EQUAL(business_logic.events, kCycles + 4);
+  BOOST_CHECK_EQUAL(pipeline.sequence<3>().sequence(), 3L);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
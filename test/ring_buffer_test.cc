@@ -31,6 +31,9 @@
 #include <boost/test/unit_test.hpp>
 #include <disruptor/ring_buffer.h>
 
+#include <memory>
+#include <stdexcept>
+
 namespace disruptor {
 namespace test {
 
@@ -58,6 +61,55 @@ BOOST_FIXTURE_TEST_CASE(VerifyWrapArround, RingBufferFixture) {
     const auto& t = ring_buffer[i];
 }
 
+BOOST_FIXTURE_TEST_CASE(PrefetchAnySequence, RingBufferFixture) {
+  // prefetching wraps like operator[] and leaves the events untouched.
+  for (int64_t i = -1; i < RING_BUFFER_SIZE * 2; i++) {
+    ring_buffer.Prefetch(i);
+    ring_buffer.PrefetchForWrite(i);
+  }
+
+  for (size_t i = 0; i < RING_BUFFER_SIZE; i++)
+    BOOST_CHECK_EQUAL(ring_buffer[i], f(i));
+}
+
+BOOST_AUTO_TEST_CASE(BuildEventsInPlaceWithFactory) {
+  // neither default constructible nor copyable.
+  struct Event {
+    explicit Event(size_t index) : value(new size_t(index)) {}
+    std::unique_ptr<size_t> value;
+  };
+
+  RingBuffer<Event, RING_BUFFER_SIZE> ring_buffer(
+      [](size_t i) { return Event(i * 10); });
+  for (size_t i = 0; i < RING_BUFFER_SIZE * 2; i++)
+    BOOST_CHECK_EQUAL(*ring_buffer[i].value, (i % RING_BUFFER_SIZE) * 10);
+}
+
+BOOST_AUTO_TEST_CASE(DestroyBuiltEventsWhenFactoryThrows) {
+  struct Event {
+    explicit Event(int* live) : live(live) { (*live)++; }
+    Event(Event&& other) : live(other.live) { (*live)++; }
+    ~Event() { (*live)--; }
+    int* live;
+  };
+
+  int live = 0;
+  auto factory = [&live](size_t i) {
+    if (i == RING_BUFFER_SIZE / 2) throw std::runtime_error("factory");
+    return Event(&live);
+  };
+  BOOST_CHECK_THROW((RingBuffer<Event, RING_BUFFER_SIZE>(factory)),
+                    std::runtime_error);
+  BOOST_CHECK_EQUAL(live, 0);
+
+  {
+    RingBuffer<Event, RING_BUFFER_SIZE> ring_buffer(
+        [&live](size_t) { return Event(&live); });
+    BOOST_CHECK_EQUAL(live, RING_BUFFER_SIZE);
+  }
+  BOOST_CHECK_EQUAL(live, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 };  // namespace test
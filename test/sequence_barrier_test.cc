@@ -81,6 +81,33 @@ BOOST_AUTO_TEST_CASE(WaitForCursor) {
   BOOST_CHECK_EQUAL(return_value.load(), kFirstSequenceValue + 1L);
 }
 
+BOOST_AUTO_TEST_CASE(WaitForKnownSequenceWithoutReadingCursor) {
+  cursor.set_sequence(5L);
+  BOOST_CHECK_EQUAL(barrier.WaitFor(kFirstSequenceValue), 5L);
+
+  // the barrier does not look at the cursor for sequences it knows about.
+  cursor.set_sequence(2L);
+  BOOST_CHECK_EQUAL(barrier.WaitFor(3L), 5L);
+  BOOST_CHECK_EQUAL(barrier.WaitFor(5L, std::chrono::microseconds(1L)), 5L);
+
+  BOOST_CHECK_EQUAL(barrier.WaitFor(6L, std::chrono::microseconds(1L)),
+                    kTimeoutSignal);
+  BOOST_CHECK_EQUAL(barrier.WaitFor(4L), 5L);
+}
+
+BOOST_AUTO_TEST_CASE(WaitForKnownSequenceWhenAlerted) {
+  cursor.set_sequence(5L);
+  BOOST_CHECK_EQUAL(barrier.WaitFor(kFirstSequenceValue), 5L);
+
+  // an alerted barrier asks its wait strategy again.
+  cursor.set_sequence(2L);
+  barrier.set_alerted(true);
+  BOOST_CHECK_EQUAL(barrier.WaitFor(3L), kAlertedSignal);
+  BOOST_CHECK_EQUAL(barrier.WaitFor(2L), 2L);
+  BOOST_CHECK_EQUAL(barrier.WaitFor(4L, std::chrono::microseconds(1L)),
+                    kAlertedSignal);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 };  // namespace test
@@ -53,7 +53,7 @@ BOOST_AUTO_TEST_CASE(ShouldStartWithValueInitialized) {
 }
 
 BOOST_AUTO_TEST_CASE(AtLeastOneCacheLine) {
-  BOOST_CHECK(sizeof(Sequence) >= CACHE_LINE_SIZE_IN_BYTES);
+  BOOST_CHECK(sizeof(Sequence) >= kCacheLinePadding);
 }
 
 BOOST_AUTO_TEST_CASE(IsCacheLineAligned) {
@@ -28,6 +28,11 @@
 
 #include <atomic>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -59,7 +64,180 @@ BOOST_AUTO_TEST_CASE(ShouldStartWithValueInitialized) {
   BOOST_CHECK(sequencer.GetCursor() == kInitialCursorValue);
 }
 
+BOOST_AUTO_TEST_CASE(ShouldWarmUpThroughConsumersThenReset) {
+  Sequence consumer_sequence;
+  sequencer.set_gating_sequences({&consumer_sequence});
+  auto barrier = sequencer.NewBarrier(std::vector<Sequence*>());
+
+  int64_t synthetic = 0;
+  std::thread consumer([&]() {
+    int64_t next_sequence = kFirstSequenceValue;
+    while (true) {
+      const int64_t available = barrier->WaitFor(next_sequence);
+      if (available == kAlertedSignal) return;
+      for (; next_sequence <= available; next_sequence++)
+        if (sequencer[next_sequence] == -1L) synthetic++;
+      consumer_sequence.set_sequence(available);
+    }
+  });
+
+  sequencer.WarmUp(RING_BUFFER_SIZE * 8, [](long& event) { event = -1L; });
+  BOOST_CHECK_EQUAL(consumer_sequence.sequence(), RING_BUFFER_SIZE * 8 - 1);
+  barrier->set_alerted(true);
+  consumer.join();
+  BOOST_CHECK_EQUAL(synthetic, RING_BUFFER_SIZE * 8);
+
+  sequencer.Reset();
+  barrier->Reset();
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), kInitialCursorValue);
+  BOOST_CHECK_EQUAL(consumer_sequence.sequence(), kInitialCursorValue);
+  BOOST_CHECK(sequencer.HasAvailableCapacity());
+  BOOST_CHECK_EQUAL(sequencer.Claim(), kFirstSequenceValue);
+  BOOST_CHECK_EQUAL(barrier->WaitFor(kFirstSequenceValue,
+                                     std::chrono::microseconds(1L)),
+                    kTimeoutSignal);
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // BlockingStrategy suite
 
+// Message passing litmus: the publishers write both fields of a slot with
+// plain stores before publishing it, a consumer must never observe a slot
+// published but not yet written, whatever the orderings the claim and
+// publish paths relaxed.
+struct StubPayload {
+  int64_t sequence;
+  int64_t complement;
+};
+
+template <typename S>
+int64_t ClaimNext(S& sequencer, SequenceLease&, std::false_type) {
+  return sequencer.Claim();
+}
+
+template <typename S>
+int64_t ClaimNext(S& sequencer, SequenceLease& lease, std::true_type) {
+  return sequencer.Claim(lease);
+}
+
+template <typename C, bool Leased = false>
+void RunMessagePassingLitmus(size_t publishers, int64_t events) {
+  constexpr size_t kSize = 16;
+  Sequencer<StubPayload, kSize, C, YieldingStrategy<>> sequencer(
+      std::array<StubPayload, kSize>{});
+  Sequence consumer_sequence;
+  sequencer.set_gating_sequences({&consumer_sequence});
+  auto barrier = sequencer.NewBarrier(std::vector<Sequence*>());
+  const int64_t total = events * publishers;
+
+  int64_t torn = 0;
+  std::thread consumer([&]() {
+    int64_t next_sequence = kFirstSequenceValue;
+    while (next_sequence < total) {
+      const int64_t available = barrier->WaitFor(next_sequence);
+      for (; next_sequence <= available; next_sequence++) {
+        const StubPayload& payload = sequencer[next_sequence];
+        if (payload.sequence != next_sequence ||
+            payload.complement != ~next_sequence)
+          torn++;
+      }
+      consumer_sequence.set_sequence(available);
+    }
+  });
+
+  std::vector<std::thread> threads;
+  for (size_t p = 0; p < publishers; p++)
+    threads.emplace_back([&sequencer, events]() {
+      SequenceLease lease;
+      for (int64_t i = 0; i < events; i++) {
+        const int64_t sequence = ClaimNext(
+            sequencer, lease, std::integral_constant<bool, Leased>());
+        sequencer[sequence].sequence = sequence;
+        sequencer[sequence].complement = ~sequence;
+        sequencer.Publish(sequence);
+      }
+    });
+  for (auto& thread : threads) thread.join();
+  consumer.join();
+
+  BOOST_CHECK_EQUAL(torn, 0);
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), total - 1);
+}
+
+BOOST_AUTO_TEST_SUITE(SequencerEmplace)
+
+BOOST_AUTO_TEST_CASE(ShouldEmplaceAndTakeMoveOnlyEvents) {
+  using Event = std::unique_ptr<int64_t>;
+  Sequencer<Event, RING_BUFFER_SIZE, SingleThreadedStrategy<RING_BUFFER_SIZE>,
+            kDefaultWaitStrategy>
+      sequencer([](size_t) { return Event(); });
+
+  const int64_t first = sequencer.Claim();
+  sequencer.Emplace(first, new int64_t(42L));
+  sequencer.Publish(first);
+
+  Event moved(new int64_t(43L));
+  const int64_t second = sequencer.EmplaceAndPublish(std::move(moved));
+  BOOST_CHECK_EQUAL(second, first + 1);
+  BOOST_CHECK(!moved);
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), second);
+
+  const Event taken = sequencer.Take(first);
+  BOOST_CHECK_EQUAL(*taken, 42L);
+  BOOST_CHECK(!sequencer[first]);
+  BOOST_CHECK_EQUAL(*sequencer.Take(second), 43L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldEmplaceEventsWhoseConstructionMayThrow) {
+  Sequencer<std::string, RING_BUFFER_SIZE,
+            SingleThreadedStrategy<RING_BUFFER_SIZE>, kDefaultWaitStrategy>
+      sequencer([](size_t) { return std::string(); });
+
+  for (int64_t i = 0; i < RING_BUFFER_SIZE * 2; i++) {
+    const int64_t sequence = sequencer.Claim();
+    sequencer.Emplace(sequence, static_cast<size_t>(i + 1), 'x');
+    sequencer.Publish(sequence);
+    BOOST_CHECK_EQUAL(sequencer.Take(sequence).size(), i + 1);
+    BOOST_CHECK(sequencer[sequence].empty());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(SequencerOrdering)
+
+BOOST_AUTO_TEST_CASE(SingleThreadedMessagePassing) {
+  RunMessagePassingLitmus<SingleThreadedStrategy<16>>(1, 200000L);
+}
+
+BOOST_AUTO_TEST_CASE(MultiThreadedMessagePassing) {
+  RunMessagePassingLitmus<MultiThreadedStrategy<16>>(4, 50000L);
+}
+
+BOOST_AUTO_TEST_CASE(LeasedMultiThreadedMessagePassing) {
+  RunMessagePassingLitmus<MultiThreadedStrategy<16, 4>, true>(4, 50000L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldPublishReleasedLease) {
+  Sequencer<long, 8, MultiThreadedStrategy<8, 4>, kDefaultWaitStrategy>
+      sequencer(std::array<long, 8>{});
+  SequenceLease lease_1;
+  SequenceLease lease_2;
+
+  sequencer.Publish(sequencer.Claim(lease_1));
+  const int64_t first = sequencer.Claim(lease_2);
+  sequencer.Publish(sequencer.Claim(lease_2));
+  sequencer.Publish(first);
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), 0L);
+
+  // the first publisher shuts down with three unclaimed sequences.
+  sequencer.ReleaseLease(lease_1, [](long& event) { event = -1L; });
+  BOOST_CHECK_EQUAL(lease_1.remaining(), 0L);
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), 5L);
+  BOOST_CHECK_EQUAL(sequencer[1L], -1L);
+  BOOST_CHECK_EQUAL(sequencer[3L], -1L);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 };  // namepspace test
 };  // namepspace disruptor
@@ -0,0 +1,172 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ShardedSequencerTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <disruptor/sharded_sequencer.h>
+
+#define RING_BUFFER_SIZE 8
+#define PRODUCERS 3
+
+namespace disruptor {
+namespace test {
+
+struct StubEvent {
+  int64_t timestamp;
+  int64_t producer;
+};
+
+using StubShardedSequencer = ShardedSequencer<StubEvent, RING_BUFFER_SIZE>;
+
+struct ShardedSequencerFixture {
+  ShardedSequencerFixture() : sequencer(PRODUCERS) {}
+
+  void Publish(size_t producer, int64_t timestamp) {
+    auto& lane = sequencer.lane(producer);
+    const int64_t sequence = lane.Claim();
+    lane[sequence] = {timestamp, static_cast<int64_t>(producer)};
+    lane.Publish(sequence);
+  }
+
+  static int64_t Timestamp(const StubEvent& event) { return event.timestamp; }
+
+  StubShardedSequencer sequencer;
+  std::vector<int64_t> timestamps;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ShardedSequencerBasic, ShardedSequencerFixture)
+
+BOOST_AUTO_TEST_CASE(ShouldGateEveryLane) {
+  BOOST_CHECK_EQUAL(sequencer.size(), PRODUCERS);
+  for (int i = 0; i < RING_BUFFER_SIZE; i++) Publish(1, i);
+  BOOST_CHECK(!sequencer.lane(1).HasAvailableCapacity());
+  BOOST_CHECK(sequencer.lane(0).HasAvailableCapacity());
+
+  sequencer.Drain([](size_t, StubEvent&, int64_t, bool) {});
+  BOOST_CHECK(sequencer.lane(1).HasAvailableCapacity());
+  BOOST_CHECK_EQUAL(sequencer.sequence(1).sequence(), RING_BUFFER_SIZE - 1);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldMergeByTimestamp) {
+  Publish(0, 1);
+  Publish(0, 4);
+  Publish(0, 7);
+  Publish(1, 2);
+  Publish(1, 3);
+  Publish(2, 5);
+  Publish(2, 6);
+
+  std::vector<size_t> lanes;
+  const auto handler = [&](size_t lane, StubEvent& event, int64_t) {
+    BOOST_CHECK_EQUAL(event.producer, lane);
+    lanes.push_back(lane);
+    timestamps.push_back(event.timestamp);
+  };
+
+  // lane 1 may still publish an event stamped 3 after its last one.
+  BOOST_CHECK_EQUAL(sequencer.DrainOrdered(handler, Timestamp), 3);
+  Publish(1, 8);
+  Publish(2, 9);
+  BOOST_CHECK_EQUAL(sequencer.DrainOrdered(handler, Timestamp), 4);
+
+  std::vector<int64_t> expected = {1, 2, 3, 4, 5, 6, 7};
+  BOOST_CHECK_EQUAL_COLLECTIONS(timestamps.begin(), timestamps.end(),
+                                expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(sequencer.sequence(0).sequence(), 2L);
+  BOOST_CHECK_EQUAL(sequencer.sequence(1).sequence(), 1L);
+  BOOST_CHECK_EQUAL(sequencer.sequence(2).sequence(), 1L);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldHoldBackEventsPastIdleLanes) {
+  const auto handler = [&](size_t, StubEvent& event, int64_t) {
+    timestamps.push_back(event.timestamp);
+  };
+
+  // lanes 1 and 2 have not published yet.
+  Publish(0, 5);
+  BOOST_CHECK_EQUAL(sequencer.DrainOrdered(handler, Timestamp), 0);
+
+  // a late event of an earlier timestamp is still merged first.
+  Publish(1, 2);
+  Publish(2, 6);
+  Publish(1, 3);
+  Publish(1, 7);
+  BOOST_CHECK_EQUAL(sequencer.DrainOrdered(handler, Timestamp), 3);
+
+  std::vector<int64_t> expected = {2, 3, 5};
+  BOOST_CHECK_EQUAL_COLLECTIONS(timestamps.begin(), timestamps.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(ShouldMergeConcurrentProducers) {
+  const int64_t iterations = RING_BUFFER_SIZE * 64;
+  std::vector<int64_t> last_timestamps(PRODUCERS, -1);
+  std::atomic<int64_t> count(0);
+  bool in_order = true;
+
+  std::thread consumer([&]() {
+    sequencer.RunOrdered(
+        [&](size_t lane, StubEvent& event, int64_t) {
+          in_order &= (event.timestamp > last_timestamps[lane]);
+          last_timestamps[lane] = event.timestamp;
+          count++;
+        },
+        Timestamp);
+  });
+
+  std::vector<std::thread> producers;
+  for (size_t p = 0; p < PRODUCERS; p++)
+    producers.emplace_back([this, p, iterations]() {
+      for (int64_t i = 0; i < iterations; i++) Publish(p, i);
+    });
+  for (auto& producer : producers) producer.join();
+
+  while (count.load() < iterations * PRODUCERS)
+    ;
+  sequencer.set_alerted(true);
+  consumer.join();
+  BOOST_CHECK(in_order);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldBuildLaneEventsWithFactory) {
+  struct Event {
+    explicit Event(int64_t value) : value(value) {}
+    int64_t value;
+  };
+
+  ShardedSequencer<Event, RING_BUFFER_SIZE> built(
+      PRODUCERS, [](size_t i) { return Event(i); }, 2);
+  for (size_t producer = 0; producer < PRODUCERS; producer++)
+    for (int64_t i = 0; i < RING_BUFFER_SIZE; i++)
+      BOOST_CHECK_EQUAL(built.lane(producer)[i].value, i);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
@@ -0,0 +1,143 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE SharedMemoryTest
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <string>
+#include <system_error>
+
+#include <boost/test/unit_test.hpp>
+
+#include <disruptor/sequence_barrier.h>
+#include <disruptor/shared_memory.h>
+
+#define RING_BUFFER_SIZE 8
+
+namespace disruptor {
+namespace test {
+
+struct StubEvent {
+  int64_t value;
+  int64_t square;
+};
+
+using StubSharedSequencer =
+    SharedSequencer<StubEvent, RING_BUFFER_SIZE,
+                    SingleThreadedStrategy<RING_BUFFER_SIZE>, 1>;
+
+struct SharedMemoryFixture {
+  SharedMemoryFixture()
+      : name("/disruptor_test_" + std::to_string(::getpid())) {
+    StubSharedSequencer::Unlink(name);
+  }
+
+  ~SharedMemoryFixture() { StubSharedSequencer::Unlink(name); }
+
+  std::string name;
+};
+
+BOOST_FIXTURE_TEST_SUITE(SharedSequencerBasic, SharedMemoryFixture)
+
+BOOST_AUTO_TEST_CASE(ShouldStartWithValueInitialized) {
+  StubSharedSequencer sequencer(name, SharedMemoryMode::kCreate);
+  BOOST_CHECK_EQUAL(sequencer.GetCursor(), kInitialCursorValue);
+  BOOST_CHECK_EQUAL(sequencer.consumer_sequence(0).sequence(),
+                    kInitialCursorValue);
+  BOOST_CHECK(sequencer.HasAvailableCapacity());
+}
+
+BOOST_AUTO_TEST_CASE(ShareStateBetweenMappings) {
+  StubSharedSequencer producer(name, SharedMemoryMode::kCreate);
+  StubSharedSequencer consumer(name, SharedMemoryMode::kOpen);
+
+  const int64_t sequence = producer.Claim();
+  producer[sequence] = {42, 42 * 42};
+  producer.Publish(sequence);
+
+  BOOST_CHECK_EQUAL(consumer.GetCursor(), sequence);
+  BOOST_CHECK_EQUAL(consumer[sequence].value, 42);
+
+  consumer.consumer_sequence(0).set_sequence(sequence);
+  BOOST_CHECK_EQUAL(producer.consumer_sequence(0).sequence(), sequence);
+}
+
+BOOST_AUTO_TEST_CASE(RejectMismatchedLayout) {
+  StubSharedSequencer producer(name, SharedMemoryMode::kCreate);
+  using OtherSequencer =
+      SharedSequencer<int64_t, RING_BUFFER_SIZE,
+                      SingleThreadedStrategy<RING_BUFFER_SIZE>, 1>;
+  BOOST_CHECK_THROW(OtherSequencer(name, SharedMemoryMode::kOpen),
+                    std::system_error);
+  BOOST_CHECK_THROW(StubSharedSequencer(name, SharedMemoryMode::kCreate),
+                    std::system_error);
+}
+
+BOOST_AUTO_TEST_CASE(PublishAcrossProcesses) {
+  const int64_t iterations = RING_BUFFER_SIZE * 64;
+  StubSharedSequencer consumer(name, SharedMemoryMode::kCreate);
+
+  const pid_t pid = ::fork();
+  BOOST_REQUIRE(pid >= 0);
+  if (pid == 0) {
+    StubSharedSequencer producer(name, SharedMemoryMode::kOpen);
+    for (int64_t i = 0; i < iterations; i++) {
+      const int64_t sequence = producer.Claim();
+      producer[sequence] = {i, i * i};
+      producer.Publish(sequence);
+    }
+    ::_exit(0);
+  }
+
+  std::vector<Sequence*> dependents;
+  SequenceBarrier<> barrier(consumer.cursor(), dependents);
+  Sequence& sequence = consumer.consumer_sequence(0);
+
+  int64_t next_sequence = kFirstSequenceValue;
+  bool in_order = true;
+  while (next_sequence < iterations) {
+    const int64_t available = barrier.WaitFor(next_sequence);
+    for (; next_sequence <= available; next_sequence++) {
+      const StubEvent& event = consumer[next_sequence];
+      in_order &= (event.value == next_sequence);
+      in_order &= (event.square == next_sequence * next_sequence);
+    }
+    sequence.set_sequence(available);
+  }
+
+  int status = -1;
+  ::waitpid(pid, &status, 0);
+  BOOST_CHECK(in_order);
+  BOOST_CHECK_EQUAL(status, 0);
+  BOOST_CHECK_EQUAL(consumer.GetCursor(), iterations - 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
@@ -0,0 +1,142 @@
+// Copyright (c) 2011-2015, Francois Saint-Jacques
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ThreadRunnerTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <disruptor/thread_runner.h>
+
+namespace disruptor {
+namespace test {
+
+BOOST_AUTO_TEST_SUITE(ThreadRunnerBasic)
+
+BOOST_AUTO_TEST_CASE(ShouldNameAndPinThreads) {
+  ThreadRunner runner;
+  char name[kMaxThreadNameLength + 1] = {0};
+  int cpu = kAnyCpu;
+  bool pinned = false;
+
+  runner.Launch(ThreadOptions("consumer-0", 0), [&]() {
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    cpu_set_t cpus;
+    pthread_getaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    pinned = CPU_COUNT(&cpus) == 1 && CPU_ISSET(0, &cpus);
+    cpu = sched_getcpu();
+  });
+  runner.Join();
+
+  BOOST_CHECK_EQUAL(std::string(name), "consumer-0");
+  BOOST_CHECK(pinned);
+  BOOST_CHECK_EQUAL(cpu, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldReadKernelCpuLists) {
+  BOOST_CHECK(CpuListContains("2-3,5\n", 2));
+  BOOST_CHECK(CpuListContains("2-3,5\n", 3));
+  BOOST_CHECK(CpuListContains("2-3,5\n", 5));
+  BOOST_CHECK(!CpuListContains("2-3,5\n", 4));
+  BOOST_CHECK(!CpuListContains("2-3,5\n", 0));
+  BOOST_CHECK(!CpuListContains("\n", 0));
+  BOOST_CHECK(!CpuListContains("", 0));
+}
+
+BOOST_AUTO_TEST_CASE(ShouldRejectBusySpinThreadsOnTheSameCore) {
+  // cpus 2 and 3 are hyper-thread siblings of core 1, cpu 4 is on core 2.
+  const std::string isolated = "2-4\n";
+  const std::vector<Spinner> spinning = {{"spinner-0", {0, 1}}};
+  const auto spinner = [](int cpu) {
+    return ThreadOptions("spinner-1", cpu, kDefaultPriority, true);
+  };
+
+  BOOST_CHECK_THROW(
+      CheckBusySpinPlacement(spinner(2), {0, 1}, isolated, spinning),
+      std::invalid_argument);
+  BOOST_CHECK_THROW(
+      CheckBusySpinPlacement(spinner(3), {0, 1}, isolated, spinning),
+      std::invalid_argument);
+  BOOST_CHECK_NO_THROW(
+      CheckBusySpinPlacement(spinner(4), {0, 2}, isolated, spinning));
+  // same core id on another package.
+  BOOST_CHECK_NO_THROW(
+      CheckBusySpinPlacement(spinner(4), {1, 1}, isolated, spinning));
+}
+
+BOOST_AUTO_TEST_CASE(ShouldRejectBusySpinThreadsOffIsolatedCpus) {
+  const std::vector<Spinner> spinning;
+  const ThreadOptions pinned("spinner-0", 1, kDefaultPriority, true);
+  const ThreadOptions unpinned("spinner-0", kAnyCpu, kDefaultPriority, true);
+
+  BOOST_CHECK_NO_THROW(
+      CheckBusySpinPlacement(pinned, {0, 1}, "1\n", spinning));
+  BOOST_CHECK_THROW(CheckBusySpinPlacement(pinned, {0, 1}, "2-3\n", spinning),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(CheckBusySpinPlacement(pinned, {0, 1}, "", spinning),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(
+      CheckBusySpinPlacement(unpinned, {-1, -1}, "0-3\n", spinning),
+      std::invalid_argument);
+
+  // threads that block may share any cpu.
+  ThreadRunner runner;
+  BOOST_CHECK_THROW(runner.Launch(unpinned, []() {}), std::invalid_argument);
+  runner.Launch(ThreadOptions("blocker-0", 0), []() {});
+  runner.Launch(ThreadOptions("blocker-1", 0), []() {});
+  BOOST_CHECK_EQUAL(runner.size(), 2);
+  runner.Join();
+  BOOST_CHECK_EQUAL(runner.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ShouldRejectInvalidOptions) {
+  ThreadRunner runner;
+  bool called = false;
+  const auto function = [&called]() { called = true; };
+
+  BOOST_CHECK_THROW(
+      runner.Launch(ThreadOptions("a-name-longer-than-15", 0), function),
+      std::invalid_argument);
+  BOOST_CHECK_THROW(runner.Launch(ThreadOptions("no-such-cpu", 1 << 20),
+                                  function),
+                    std::system_error);
+  BOOST_CHECK_THROW(
+      runner.Launch(ThreadOptions("bad-priority", kAnyCpu, 1000), function),
+      std::system_error);
+
+  runner.Join();
+  BOOST_CHECK(!called);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};  // namespace test
+};  // namespace disruptor
@@ -335,6 +335,146 @@ BOOST_AUTO_TEST_CASE(SignalAlertWaitingOnDependents) {
 
 BOOST_AUTO_TEST_SUITE_END()  // SleepingStrategy suite
 
+/* AdaptiveStrategy */
+using AdaptiveStrategyFixture = StrategyFixture<AdaptiveStrategy<>>;
+BOOST_FIXTURE_TEST_SUITE(AdaptiveStrategy, AdaptiveStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(WaitForCursor) {
+  std::atomic<int64_t> return_value(kInitialCursorValue);
+
+  std::thread waiter([this, &return_value]() {
+    return_value.store(
+        strategy.WaitFor(kFirstSequenceValue, cursor, dependents, alerted));
+  });
+
+  BOOST_CHECK_EQUAL(return_value.load(), kInitialCursorValue);
+  std::thread([this]() {
+    cursor.IncrementAndGet(1L);
+    strategy.SignalAllWhenBlocking();
+  }).join();
+  waiter.join();
+  BOOST_CHECK_EQUAL(return_value.load(), kFirstSequenceValue);
+}
+
+BOOST_AUTO_TEST_CASE(SignalTimeoutWaitingOnCursor) {
+  std::atomic<int64_t> return_value(kInitialCursorValue);
+
+  std::thread waiter([this, &return_value]() {
+    return_value.store(strategy.WaitFor(kFirstSequenceValue, cursor, dependents,
+                                        alerted,
+                                        std::chrono::microseconds(1L)));
+  });
+
+  waiter.join();
+  BOOST_CHECK_EQUAL(return_value.load(), kTimeoutSignal);
+
+  std::thread waiter2([this, &return_value]() {
+    return_value.store(strategy.WaitFor(kFirstSequenceValue, cursor, dependents,
+                                        alerted, std::chrono::seconds(1L)));
+  });
+
+  cursor.IncrementAndGet(1L);
+  strategy.SignalAllWhenBlocking();
+  waiter2.join();
+  BOOST_CHECK_EQUAL(return_value.load(), kFirstSequenceValue);
+}
+
+BOOST_AUTO_TEST_CASE(WaitForDependents) {
+  std::atomic<int64_t> return_value(kInitialCursorValue);
+
+  std::thread waiter([this, &return_value]() {
+    return_value.store(strategy.WaitFor(kFirstSequenceValue, cursor,
+                                        allDependents(), alerted));
+  });
+
+  cursor.IncrementAndGet(1L);
+  strategy.SignalAllWhenBlocking();
+  // dependents haven't moved, WaitFor() should still block.
+  BOOST_CHECK_EQUAL(return_value.load(), kInitialCursorValue);
+
+  sequence_1.IncrementAndGet(1L);
+  BOOST_CHECK_EQUAL(return_value.load(), kInitialCursorValue);
+
+  sequence_2.IncrementAndGet(1L);
+  BOOST_CHECK_EQUAL(return_value.load(), kInitialCursorValue);
+
+  sequence_3.IncrementAndGet(1L);
+  waiter.join();
+  BOOST_CHECK_EQUAL(return_value.load(), kFirstSequenceValue);
+}
+
+BOOST_AUTO_TEST_CASE(SignalAlertWaitingOnDependents) {
+  std::atomic<int64_t> return_value(kInitialCursorValue);
+
+  std::thread waiter([this, &return_value]() {
+    return_value.store(strategy.WaitFor(kFirstSequenceValue, cursor,
+                                        allDependents(), alerted));
+  });
+
+  cursor.IncrementAndGet(1L);
+  strategy.SignalAllWhenBlocking();
+  // dependents haven't moved, WaitFor() should still block.
+  BOOST_CHECK_EQUAL(return_value.load(), kInitialCursorValue);
+
+  sequence_1.IncrementAndGet(1L);
+  BOOST_CHECK_EQUAL(return_value.load(), kInitialCursorValue);
+
+  sequence_2.IncrementAndGet(1L);
+  BOOST_CHECK_EQUAL(return_value.load(), kInitialCursorValue);
+
+  alerted.store(true);
+
+  waiter.join();
+  BOOST_CHECK_EQUAL(return_value.load(), kAlertedSignal);
+}
+
+BOOST_AUTO_TEST_CASE(AdaptPhaseToObservedWaits) {
+  disruptor::AdaptiveStrategy<1000L, 100000L> adaptive;
+  BOOST_CHECK(adaptive.phase() == WaitPhase::kSpin);
+
+  // a long wait for the cursor parks the next waits.
+  std::thread publisher([this]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2L));
+    cursor.IncrementAndGet(1L);
+  });
+  BOOST_CHECK_EQUAL(
+      adaptive.WaitFor(kFirstSequenceValue, cursor, dependents, alerted),
+      kFirstSequenceValue);
+  publisher.join();
+  BOOST_CHECK(adaptive.expected_wait_nanos() >= 100000L);
+  BOOST_CHECK(adaptive.phase() == WaitPhase::kPark);
+
+  // events available without waiting bring spinning back.
+  for (int i = 0; i < 64; i++)
+    adaptive.WaitFor(kFirstSequenceValue, cursor, dependents, alerted);
+  BOOST_CHECK(adaptive.phase() == WaitPhase::kSpin);
+}
+
+BOOST_AUTO_TEST_CASE(AdaptThresholdsToObservedWaits) {
+  disruptor::AdaptiveStrategy<4000L, 100000L> adaptive;
+  // events always available, a miss is an outlier and soon stops spinning.
+  BOOST_CHECK_EQUAL(adaptive.spin_threshold_nanos(), kMinAdaptiveSpinNanos);
+  BOOST_CHECK_EQUAL(adaptive.yield_threshold_nanos(), 4000L);
+
+  // a long wait stretches both thresholds up to their bounds.
+  std::thread publisher([this]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2L));
+    cursor.IncrementAndGet(1L);
+  });
+  adaptive.WaitFor(kFirstSequenceValue, cursor, dependents, alerted);
+  publisher.join();
+  BOOST_CHECK(adaptive.wait_deviation_nanos() > 0);
+  BOOST_CHECK_EQUAL(adaptive.spin_threshold_nanos(), 4000L);
+  BOOST_CHECK_EQUAL(adaptive.yield_threshold_nanos(), 100000L);
+
+  // and they shrink back once waits are short again.
+  for (int i = 0; i < 128; i++)
+    adaptive.WaitFor(kFirstSequenceValue, cursor, dependents, alerted);
+  BOOST_CHECK_EQUAL(adaptive.spin_threshold_nanos(), kMinAdaptiveSpinNanos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // AdaptiveStrategy suite
+
 /* BlockingStrategy */
 using BlockingStrategyFixture = StrategyFixture<BlockingStrategy>;
 BOOST_FIXTURE_TEST_SUITE(BlockingStrategy, BlockingStrategyFixture)